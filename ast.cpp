@@ -42,6 +42,16 @@
 AST::AST() {}
 AST::~AST() {}
 
+void ASTContext::error(const std::string & msg) const
+{
+	if(!errors){
+		std::cerr << msg << std::endl;
+		std::exit(1);
+	}
+	if(errors->empty())
+		*errors = msg;
+}
+
 PrintStmtAST::PrintStmtAST(PrintIntroAST * intro,ExprListAST* args)
 	: callargs(args)
 	, print_intro(intro)
@@ -58,6 +68,7 @@ DimAST::DimAST(const std::string _name, ExprTypeASTPtr _type)
 
 VariableDimAST::VariableDimAST(const std::string _name, ExprTypeASTPtr _type)
 	: DimAST(_name, _type)
+	, alloca_var(NULL)
 {}
 
 FunctionDimAST::FunctionDimAST(const std::string _name, ExprTypeASTPtr _type, ArgumentDimsAST * _callargs)
@@ -66,6 +77,9 @@ FunctionDimAST::FunctionDimAST(const std::string _name, ExprTypeASTPtr _type, Ar
 	, returnblock(NULL)
 	, target(NULL)
 	, retval(NULL)
+	, linkage(STATIC)
+	, firstline(0)
+	, lastline(0)
 {
 	this->body = CodeBlockASTPtr(body);
 }
@@ -133,12 +147,14 @@ void CodeBlockAST::addchild(StatementsAST* items)
 
 CodeBlockAST::CodeBlockAST(StatementsAST* items)
 	: parent(NULL)
+	, globalscope(false)
 {
     addchild(items);
 }
 
 CodeBlockAST::CodeBlockAST(StatementAST* item)
 	: parent(NULL)
+	, globalscope(false)
 {
     addchild(item);
 }
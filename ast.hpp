@@ -24,6 +24,7 @@
 #include <string>
 #include <list>
 #include <map>
+#include <vector>
 #include <iostream>
 #include <memory>
 
@@ -75,6 +76,8 @@ public:
 		, codeblock(0)
 		, block(0)
 		, func(0)
+		, temps(0)
+		, errors(0)
 	{}
 
 	llvm::Function*		llvmfunc;	// 当前的函数位置.
@@ -82,6 +85,13 @@ public:
 	llvm::BasicBlock*	block;		// 当前的插入位置.
 	llvm::Module*		module;		// 模块.
 	FunctionDimAST*		func;
+	std::vector<llvm::Value*>*	temps;	// 当前语句生成的临时字符串, 语句用完以后释放.
+	std::string*		errors;	// 代码生成时发现的源码错误, 只留第一个.
+
+	// 报告源码里的错误 (未定义的变量, 不支持的运算...). 调用的地方接着生成一个占位的值,
+	// 让代码生成走完, 入口 (generate, Repl::eval) 发现有错就丢掉整个 module.
+	// 没有设置 errors 的话照旧打印出来退出.
+	void error(const std::string & msg) const;
 };
 
 // allow us to use shared ptr to manage the memory
@@ -177,6 +187,7 @@ public:
 
 	CodeBlockAST*							parent;		// 父作用域.
 	std::map<std::string, DimAST*>			symbols;	// 符号表, 映射到定义语句,获得定义语句.
+	bool									globalscope; // 在这里 DIM 的变量是全局变量, REPL 用.
 
     virtual llvm::BasicBlock* Codegen(ASTContext ctx);
 	virtual llvm::BasicBlock* GenLeave(ASTContext);
@@ -185,7 +196,7 @@ public:
 	void addchild(StatementAST* item);
 	void addchild(StatementsAST* items);
 
-	CodeBlockAST() : parent(NULL) {}
+	CodeBlockAST() : parent(NULL), globalscope(false) {}
     CodeBlockAST(StatementsAST * items);
 	CodeBlockAST(StatementAST * item);
 
@@ -240,6 +251,8 @@ class VariableDimAST : public DimAST
 {
 	llvm::Value* alloca_var;
 public:
+	std::vector<llvm::Value*>	extents; // ARRAYDIM 第二维起各维的大小 (alloca 或者全局变量)
+
 	VariableDimAST(const std::string _name,  ExprTypeASTPtr _type);
 	virtual llvm::BasicBlock* Codegen(ASTContext);
     virtual llvm::BasicBlock* valuedegen(ASTContext ctx);
@@ -292,9 +305,11 @@ private:
 	llvm::Function*			target;
 	llvm::Value*			retval; // allocated for return value, should use that for return.
 	llvm::Value*			setret(ASTContext ctx, ExprASTPtr expr);
+	llvm::FunctionType*		functype(ASTContext ctx);
 public:
 	
-	Linkage		linkage; //链接类型。static? extern ?
+	Linkage		linkage; //链接类型。默认 STATIC, EXPORT 的是 EXTERN.
+	int			firstline, lastline; // 源码里 FUNCTION/SUB 到 END 的行号, 热重载用.
 	std::list<VariableDimASTPtr> args_type; //checked by CallExpr.
 	ArgumentDimsASTPtr	callargs; // 加到 body 这个 codeblock 符号表,这样 body 能访问到.
 	CodeBlockASTPtr	body; //函数体.
@@ -302,12 +317,14 @@ public:
     FunctionDimAST(const std::string _name, ExprTypeASTPtr, ArgumentDimsAST * callargs = NULL);
 	//如果是声明, 为 dim 生成 llvm::Function * 声明供使用.
     virtual llvm::BasicBlock* Codegen(ASTContext);
+	// 在别的 module 里定义的函数, 只生成声明并登记到符号表. 多文件工程用.
+	llvm::BasicBlock* declare(ASTContext);
 
 	//get a pointer to function
     virtual	llvm::Value* getptr(ASTContext ctx);
 	virtual	llvm::Value* getval(ASTContext ctx)
 	{
-		return this->target;
+		return getptr(ctx);
 	}
 };
 
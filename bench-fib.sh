@@ -0,0 +1,14 @@
+#!/bin/sh
+# compare -O0 .. -O3 on fib.bas, end to end through the JIT.
+#
+#   ./bench-fib.sh [path/to/llvmtest] [file.bas]
+#
+# per-phase timings come from --time (stderr), the total from time(1).
+
+QBC=${1:-./_build/llvmtest}
+SRC=${2:-fib.bas}
+
+for level in 0 1 2 3 ; do
+	echo "==== -O$level ===="
+	/usr/bin/time -p "$QBC" --run --time -O$level "$SRC" > /dev/null
+done 2>&1 | tee bench_output.txt
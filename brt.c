@@ -0,0 +1,851 @@
+/*
+    BASIC runtime, linked into every compiled program
+    Copyright (C) 2012  microcai <microcai@fedoraproject.org>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifdef __linux__
+#define _GNU_SOURCE /* mremap */
+#endif
+
+#include <limits.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#include "brt.h"
+
+#ifndef BRT_LEAN
+
+/* map the BASIC file number to a FILE* */
+static FILE * brt_file(long fileno)
+{
+	switch(fileno){
+		case 0:
+			return stdout;
+		case 2:
+			return stderr;
+	}
+	return stdout;
+}
+
+int brt_print(long fileno, const char * fmt, ...)
+{
+	va_list ap;
+	int ret;
+
+	va_start(ap, fmt);
+	ret = vfprintf(brt_file(fileno), fmt, ap);
+	va_end(ap);
+	return ret;
+}
+
+static void brt_error(const char * msg)
+{
+	fflush(stdout);
+	fputs(msg, stderr);
+}
+
+#else /* BRT_LEAN */
+
+/*
+ * lean runtime for standalone executables (libbrtlean.a, linked -static).
+ *
+ * the generated code calls printf for PRINT, and LLVM may turn that into
+ * puts or putchar. all three are provided here on top of write(2) with a
+ * small buffer, so a program never touches stdio and has nothing to set up
+ * before main. only the conversions PRINT generates are supported:
+ * %d %ld %s and %%.
+ */
+#include <errno.h>
+#include <unistd.h>
+
+static char brt_outbuf[4096];
+static size_t brt_outlen;
+static int brt_outstate; /* 0: unknown, 1: buffered, 2: line buffered (tty) */
+static int brt_outfd = 1;
+
+static void brt_write(int fd, const char * buf, size_t len)
+{
+	while(len){
+		ssize_t n = write(fd, buf, len);
+		if(n < 0 && errno == EINTR)
+			continue;
+		if(n <= 0)
+			return;
+		buf += n;
+		len -= n;
+	}
+}
+
+static void brt_flush(void)
+{
+	brt_write(brt_outfd, brt_outbuf, brt_outlen);
+	brt_outlen = 0;
+}
+
+static void brt_putc(char c)
+{
+	if(!brt_outstate){
+		brt_outstate = isatty(1) ? 2 : 1;
+		atexit(brt_flush);
+	}
+
+	if(brt_outlen == sizeof(brt_outbuf))
+		brt_flush();
+	brt_outbuf[brt_outlen++] = c;
+
+	if(c == '\n' && brt_outstate == 2)
+		brt_flush();
+}
+
+static int brt_putstr(const char * str)
+{
+	int count = 0;
+
+	if(!str)
+		str = "(null)";
+	for(; *str; str++, count++)
+		brt_putc(*str);
+	return count;
+}
+
+static int brt_putlong(long value)
+{
+	char digits[24];
+	int len = 0, count;
+	unsigned long u = value < 0 ? 0 - (unsigned long) value : (unsigned long) value;
+
+	do{
+		digits[len++] = '0' + u % 10;
+		u /= 10;
+	}while(u);
+
+	if(value < 0)
+		digits[len++] = '-';
+
+	for(count = len; len; )
+		brt_putc(digits[--len]);
+	return count;
+}
+
+static int brt_vprint(const char * fmt, va_list ap)
+{
+	int count = 0;
+
+	for(; *fmt; fmt++)
+	{
+		if(*fmt != '%'){
+			brt_putc(*fmt);
+			count++;
+			continue;
+		}
+
+		switch(*++fmt){
+			case 'l':
+				if(fmt[1] == 'd'){
+					fmt++;
+					count += brt_putlong(va_arg(ap, long));
+				}
+				break;
+			case 'd':
+				count += brt_putlong(va_arg(ap, int));
+				break;
+			case 's':
+				count += brt_putstr(va_arg(ap, const char *));
+				break;
+			case '%':
+				brt_putc('%');
+				count++;
+				break;
+			case '\0':
+				return count;
+		}
+	}
+	return count;
+}
+
+int printf(const char * fmt, ...)
+{
+	va_list ap;
+	int ret;
+
+	va_start(ap, fmt);
+	ret = brt_vprint(fmt, ap);
+	va_end(ap);
+	return ret;
+}
+
+int puts(const char * str)
+{
+	int ret = brt_putstr(str);
+
+	brt_putc('\n');
+	return ret + 1;
+}
+
+int putchar(int c)
+{
+	brt_putc(c);
+	return (unsigned char) c;
+}
+
+/* file number 2 is stderr, written out right away; everything else is the screen */
+int brt_print(long fileno, const char * fmt, ...)
+{
+	va_list ap;
+	int ret;
+
+	if(fileno == 2){
+		brt_flush();
+		brt_outfd = 2;
+	}
+
+	va_start(ap, fmt);
+	ret = brt_vprint(fmt, ap);
+	va_end(ap);
+
+	if(fileno == 2){
+		brt_flush();
+		brt_outfd = 1;
+	}
+	return ret;
+}
+
+static void brt_error(const char * msg)
+{
+	brt_flush();
+	brt_write(2, msg, strlen(msg));
+}
+
+#endif /* BRT_LEAN */
+
+long long brt_steps = LLONG_MAX;
+
+/*
+ * header in front of every block from brt_malloc, of heap strings and of
+ * array storage, 32 bytes keeps the payload 16 byte aligned. blocks
+ * allocated while a budget runs are linked on brt_blocks, so that
+ * brt_budget_stop() can free what the program left behind. the others
+ * point at themselves.
+ */
+struct brt_block {
+	struct brt_block * prev;
+	struct brt_block * next;
+	size_t size;
+	size_t flags;
+};
+
+#define BRT_BLOCK_TRACKED	1
+#define BRT_BLOCK_MAPPED	2 /* array storage from mmap(), size is the length of the mapping */
+
+static struct brt_block brt_blocks = { &brt_blocks, &brt_blocks, 0, 0 };
+static int brt_budgeting;
+static size_t brt_heap_used;
+static size_t brt_heap_limit = (size_t) -1;
+static void (*brt_on_exceeded)(const char * what);
+
+static void brt_block_link(struct brt_block * block, size_t size, size_t flags)
+{
+	block->size = size;
+	block->flags = flags;
+
+	if(!brt_budgeting){
+		block->prev = block->next = block;
+		return;
+	}
+
+	block->flags |= BRT_BLOCK_TRACKED;
+	block->prev = &brt_blocks;
+	block->next = brt_blocks.next;
+	brt_blocks.next->prev = block;
+	brt_blocks.next = block;
+}
+
+static void brt_block_unlink(struct brt_block * block)
+{
+	block->prev->next = block->next;
+	block->next->prev = block->prev;
+}
+
+/* realloc() or mremap() moved the block, the neighbours still point at the old place */
+static void brt_block_moved(struct brt_block * block, size_t size)
+{
+	block->size = size;
+
+	if(block->flags & BRT_BLOCK_TRACKED){
+		block->prev->next = block;
+		block->next->prev = block;
+	}else{
+		block->prev = block->next = block;
+	}
+}
+
+static void brt_block_free(struct brt_block * block)
+{
+	brt_block_unlink(block);
+
+#ifdef __linux__
+	if(block->flags & BRT_BLOCK_MAPPED){
+		munmap(block, block->size);
+		return;
+	}
+#endif
+	free(block);
+}
+
+static void brt_exceed(const char * what)
+{
+	if(brt_on_exceeded)
+		brt_on_exceeded(what);
+
+	brt_error(what);
+	brt_error(" budget exceeded\n");
+	exit(1);
+}
+
+void brt_abort(const char * msg)
+{
+	brt_error(msg);
+	exit(1);
+}
+
+/* count size more bytes against the heap quota */
+static void brt_heap_charge(size_t size)
+{
+	if(size > brt_heap_limit - brt_heap_used)
+		brt_exceed("heap");
+	brt_heap_used += size;
+}
+
+/* brt_budget_stop() starts from zero again, memory charged before that may be released later */
+static void brt_heap_release(size_t size)
+{
+	brt_heap_used -= size < brt_heap_used ? size : brt_heap_used;
+}
+
+void brt_budget_start(long long steps, size_t heap, void (*onexceeded)(const char * what))
+{
+	brt_budgeting = 1;
+	brt_steps = steps;
+	brt_heap_limit = heap;
+	brt_on_exceeded = onexceeded;
+}
+
+void brt_budget_stop(void)
+{
+	while(brt_blocks.next != &brt_blocks)
+		brt_block_free(brt_blocks.next);
+
+	brt_budgeting = 0;
+	brt_heap_used = 0;
+	brt_steps = LLONG_MAX;
+	brt_heap_limit = (size_t) -1;
+	brt_on_exceeded = NULL;
+}
+
+void brt_budget_exceeded(void)
+{
+	brt_exceed("step");
+}
+
+void * brt_malloc(long size)
+{
+	struct brt_block * block;
+
+	if(size < 0)
+		brt_exceed("heap");
+	brt_heap_charge(size);
+
+	block = malloc(sizeof(*block) + size);
+	if(!block){
+		brt_heap_release(size);
+		return NULL;
+	}
+
+	brt_block_link(block, size, 0);
+	return block + 1;
+}
+
+/* only for blocks from brt_malloc */
+static void * brt_realloc(void * ptr, long size)
+{
+	struct brt_block * block = (struct brt_block *) ptr - 1;
+
+	if(size < 0)
+		brt_exceed("heap");
+	if((size_t) size > block->size)
+		brt_heap_charge(size - block->size);
+	else
+		brt_heap_release(block->size - size);
+
+	block = realloc(block, sizeof(*block) + size);
+	if(!block)
+		return NULL;
+
+	brt_block_moved(block, size);
+	return block + 1;
+}
+
+void * brt_calloc(long count, long size)
+{
+	void * ptr;
+
+	if(count < 0 || size < 0 || (size && count > LONG_MAX / size))
+		brt_exceed("heap");
+
+	ptr = brt_malloc(count * size);
+	if(ptr)
+		memset(ptr, 0, count * size);
+	return ptr;
+}
+
+void brt_free(void * ptr)
+{
+	struct brt_block * block;
+
+	if(!ptr)
+		return;
+
+	block = (struct brt_block *) ptr - 1;
+	brt_heap_release(block->size);
+	brt_block_free(block);
+}
+
+char * brt_strdup(const char * str)
+{
+	size_t len = strlen(str) + 1;
+	char * copy = brt_malloc(len);
+
+	if(copy)
+		memcpy(copy, str, len);
+	return copy;
+}
+
+/*
+ * BASIC arrays, see QBArray in qbc.h
+ *
+ * a multi-dimensional array is stored row-major like in C: stride is the
+ * size of a row, that is what the first subscript moves by, the other
+ * subscripts are folded into a column within the row by the compiler.
+ * for a plain array a row is one element.
+ *
+ * btr_qbarray_at() grows the storage when it's given an index past the end,
+ * assignments go through it. reads go through btr_qbarray_get(), which
+ * never grows the array, an element past the end reads as 0.
+ * at least doubling it, so filling an array element by element is amortized
+ * O(1). new elements read as 0. the storage is 64 byte aligned, a cache line
+ * and enough for any vector load. from 2MB on it's mmap()ed directly and
+ * advised to use transparent huge pages, which also lets it grow by mremap()
+ * without copying. the storage counts against the heap budget.
+ *
+ * a brt_block sits in the BRT_ARRAY_HEADER bytes in front of the storage,
+ * its size is the whole allocation.
+ */
+#define BRT_ARRAY_ALIGN	64
+#define BRT_ARRAY_HEADER	BRT_ARRAY_ALIGN
+#define BRT_ARRAY_HUGE	((size_t) 2 << 20)
+
+static struct brt_block * brt_array_block(void * ptr)
+{
+	return (struct brt_block *) ((char *) ptr - BRT_ARRAY_HEADER);
+}
+
+static int brt_array_huge(size_t size)
+{
+#ifdef __linux__
+	return size >= BRT_ARRAY_HUGE;
+#else
+	return 0;
+#endif
+}
+
+/* zeroed storage of size bytes */
+static void * brt_array_alloc(size_t size)
+{
+	void * ptr;
+
+	size += BRT_ARRAY_HEADER;
+
+#ifdef __linux__
+	if(brt_array_huge(size)){
+		ptr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if(ptr == MAP_FAILED)
+			return NULL;
+#ifdef MADV_HUGEPAGE
+		madvise(ptr, size, MADV_HUGEPAGE);
+#endif
+		brt_block_link(ptr, size, BRT_BLOCK_MAPPED);
+		return (char *) ptr + BRT_ARRAY_HEADER;
+	}
+#endif
+
+	if(posix_memalign(&ptr, BRT_ARRAY_ALIGN, size))
+		return NULL;
+	memset(ptr, 0, size);
+	brt_block_link(ptr, size, 0);
+	return (char *) ptr + BRT_ARRAY_HEADER;
+}
+
+static void brt_array_release(void * ptr)
+{
+	if(ptr)
+		brt_block_free(brt_array_block(ptr));
+}
+
+void brt_array_grow(QBArray * array, size_t needed)
+{
+	size_t capacity = array->capacity * 2;
+	void * ptr = NULL;
+
+	if(capacity < needed)
+		capacity = needed;
+	if(capacity < BRT_ARRAY_ALIGN)
+		capacity = BRT_ARRAY_ALIGN;
+	capacity = (capacity + BRT_ARRAY_ALIGN - 1) & ~(size_t)(BRT_ARRAY_ALIGN - 1);
+	if(brt_array_huge(capacity))
+		capacity = (capacity + BRT_ARRAY_HUGE - 1) & ~(BRT_ARRAY_HUGE - 1);
+
+	brt_heap_charge(capacity - array->capacity);
+
+#ifdef __linux__
+	/* huge to huge: the kernel moves the pages, nothing is copied */
+	if(array->ptr && (brt_array_block(array->ptr)->flags & BRT_BLOCK_MAPPED)){
+		struct brt_block * block = brt_array_block(array->ptr);
+
+		block = mremap(block, block->size, capacity + BRT_ARRAY_HEADER, MREMAP_MAYMOVE);
+		if(block == MAP_FAILED){
+			ptr = NULL;
+		}else{
+			brt_block_moved(block, capacity + BRT_ARRAY_HEADER);
+			ptr = (char *) block + BRT_ARRAY_HEADER;
+		}
+	}else
+#endif
+	{
+		ptr = brt_array_alloc(capacity);
+		if(ptr && array->ptr){
+			memcpy(ptr, array->ptr, array->capacity);
+			brt_array_release(array->ptr);
+		}
+	}
+
+	if(!ptr)
+		brt_abort("out of memory for array\n");
+
+	array->ptr = ptr;
+	array->capacity = capacity;
+}
+
+void btr_qbarray_new(QBArray * array, long elementsize)
+{
+	array->ptr = NULL;
+	array->elementsize = elementsize;
+	array->stride = elementsize;
+	array->capacity = 0;
+}
+
+/* 读到还没分配的地方, 读出来的是 0. 够放任何一种元素 */
+static const long brt_array_zero[2];
+
+/* index 行的偏移 */
+static size_t brt_array_row(QBArray * array, long index)
+{
+	if(index < 0 || (size_t) index > (LONG_MAX - array->stride) / array->stride)
+		brt_abort("array index out of range\n");
+
+	return (size_t) index * array->stride;
+}
+
+/* 一行里第 column 个元素的偏移 */
+static size_t brt_array_column(QBArray * array, long column)
+{
+	if(column < 0 || (size_t) column >= array->stride / array->elementsize)
+		brt_abort("array index out of range\n");
+
+	return (size_t) column * array->elementsize;
+}
+
+void * btr_qbarray_at(QBArray * array, long index)
+{
+	size_t offset = brt_array_row(array, index);
+
+	if(offset + array->stride > array->capacity)
+		brt_array_grow(array, offset + array->stride);
+
+	return (char *) array->ptr + offset;
+}
+
+void * btr_qbarray_cell(QBArray * array, long row, long column)
+{
+	size_t columnoffset = brt_array_column(array, column);
+
+	return (char *) btr_qbarray_at(array, row) + columnoffset;
+}
+
+void * btr_qbarray_get(QBArray * array, long index)
+{
+	size_t offset = brt_array_row(array, index);
+
+	if(offset + array->stride > array->capacity)
+		return (void *) brt_array_zero;
+
+	return (char *) array->ptr + offset;
+}
+
+void * btr_qbarray_getcell(QBArray * array, long row, long column)
+{
+	size_t columnoffset = brt_array_column(array, column);
+	size_t offset = brt_array_row(array, row);
+
+	if(offset + array->stride > array->capacity)
+		return (void *) brt_array_zero;
+
+	return (char *) array->ptr + offset + columnoffset;
+}
+
+void btr_qbarray_dim(QBArray * array, long rows, long rowsize)
+{
+	if(rows < 0 || rowsize <= 0 || (rows && rowsize > LONG_MAX / rows))
+		brt_abort("bad array dimensions\n");
+
+	/* DIM again starts over with a zeroed array */
+	btr_qbarray_free(array);
+	array->stride = rowsize;
+
+	if(rows)
+		brt_array_grow(array, (size_t) rows * rowsize);
+}
+
+void brt_array_free(QBArray * array)
+{
+	brt_array_release(array->ptr);
+	brt_heap_release(array->capacity);
+
+	array->ptr = NULL;
+	array->capacity = 0;
+}
+
+void btr_qbarray_free(QBArray * array)
+{
+	if(array->ptr)
+		brt_array_free(array);
+}
+
+/*
+ * BASIC strings, see struct brt_string in brt.h
+ *
+ * the header in front of the characters keeps the length, so no strlen, and
+ * a reference count, so assigning a string is a count bump instead of a
+ * copy. constants are emitted by the compiler with the same header and a
+ * negative count, they are never freed. NULL is the empty string.
+ *
+ * short strings skip the heap altogether, they are copied into the
+ * variable (struct brt_strvar), which is as cheap as the count bump.
+ *
+ * the functions the compiler calls touch no global state, so that the
+ * optimizer can inline them (see runtime.hpp). allocating and the heap
+ * budget are in brt_str_reserve(), brt_str_resize() and brt_str_free(),
+ * which are called out of line. the same goes for arrays and
+ * brt_array_grow() / brt_array_free().
+ */
+struct brt_string * brt_str_reserve(long length, long capacity)
+{
+	struct brt_string * str;
+	size_t size = sizeof(*str) + capacity + 1;
+
+	str = brt_malloc(size);
+	if(!str)
+		brt_abort("out of memory for string\n");
+
+	str->refcount = 1;
+	str->length = length;
+	str->capacity = capacity;
+	str->data[length] = 0;
+	return str;
+}
+
+/* str 只有一个引用, 扩大到能放 capacity 个字符, 可能会搬家 */
+struct brt_string * brt_str_resize(struct brt_string * str, long capacity)
+{
+	str = brt_realloc(str, sizeof(*str) + capacity + 1);
+	if(!str)
+		brt_abort("out of memory for string\n");
+
+	str->capacity = capacity;
+	return str;
+}
+
+void brt_str_free(struct brt_string * str)
+{
+	brt_free(str);
+}
+
+static struct brt_string * brt_str_alloc(long length)
+{
+	return brt_str_reserve(length, length);
+}
+
+/* 短字符串直接放在变量里 */
+static char * brt_str_inline(struct brt_strvar * var, long length)
+{
+	var->refcount = 0;
+	var->length = length;
+	var->capacity = BRT_STR_INLINE - 1;
+	var->data[length] = 0;
+	return var->ptr = var->data;
+}
+
+long brt_str_len(const char * str)
+{
+	return str ? brt_string_of(str)->length : 0;
+}
+
+char * brt_str_concat(struct brt_strvar * tmp, const char * a, const char * b)
+{
+	long alen = brt_str_len(a), blen = brt_str_len(b);
+	char * data;
+
+	if(alen + blen < BRT_STR_INLINE)
+		data = brt_str_inline(tmp, alen + blen);
+	else
+		data = tmp->ptr = brt_str_alloc(alen + blen)->data;
+
+	if(alen)
+		memcpy(data, a, alen);
+	if(blen)
+		memcpy(data + alen, b, blen);
+	return data;
+}
+
+char * brt_str_retain(char * str)
+{
+	struct brt_string * header, * copy;
+
+	if(!str)
+		return NULL;
+
+	header = brt_string_of(str);
+	if(header->refcount > 0)
+		header->refcount++;
+	else if(header->refcount == 0){
+		copy = brt_str_alloc(header->length);
+		memcpy(copy->data, str, header->length);
+		return copy->data;
+	}
+	return str;
+}
+
+void brt_str_release(char * str)
+{
+	struct brt_string * header;
+
+	if(!str)
+		return;
+
+	header = brt_string_of(str);
+	if(header->refcount > 0 && --header->refcount == 0)
+		brt_str_free(header);
+}
+
+void brt_str_assign(struct brt_strvar * var, char * str)
+{
+	long length = brt_str_len(str);
+
+	if(str == var->ptr)
+		return;
+
+	/* 常量不用拷, 别的短字符串拷进来, 旧值先放掉, str 不会在它里面 */
+	if(str && brt_string_of(str)->refcount >= 0 && length < BRT_STR_INLINE){
+		brt_str_release(var->ptr);
+		memcpy(brt_str_inline(var, length), str, length);
+		return;
+	}
+
+	str = brt_str_retain(str);
+	brt_str_release(var->ptr);
+	var->ptr = str;
+}
+
+/*
+ * var = str + tail. when str is what var holds and nobody else does, the
+ * characters go right behind it, the heap string growing to twice the
+ * size when full, so building a string in a loop is linear.
+ */
+void brt_str_append(struct brt_strvar * var, char * str, const char * tail)
+{
+	long length = brt_str_len(str), taillength = brt_str_len(tail);
+	long total = length + taillength;
+	struct brt_string * header;
+	char buf[BRT_STR_INLINE];
+
+	/* 只有 var 自己拿着 str (放在变量里的, 或者引用计数是 1), 才能就地追加 */
+	if(str && str == var->ptr && (unsigned long) brt_string_of(str)->refcount <= 1){
+		header = brt_string_of(str);
+
+		if(header->capacity >= total){
+			memmove(str + length, tail, taillength);
+			str[total] = 0;
+			header->length = total;
+			return;
+		}
+
+		if(header->refcount){
+			int self = tail == str; /* s$ = s$ + s$ */
+
+			header = brt_str_resize(header, 2 * total);
+			if(self)
+				tail = header->data;
+
+			header->length = total;
+			memcpy(header->data + length, tail, taillength);
+			header->data[total] = 0;
+			var->ptr = header->data;
+			return;
+		}
+	}
+
+	if(total < BRT_STR_INLINE){
+		/* str 和 tail 可能就在 var 里, 先拼到 buf */
+		if(length)
+			memcpy(buf, str, length);
+		if(taillength)
+			memcpy(buf + length, tail, taillength);
+		brt_str_release(var->ptr);
+		memcpy(brt_str_inline(var, total), buf, total);
+		return;
+	}
+
+	header = brt_str_reserve(total, 2 * total);
+	if(length)
+		memcpy(header->data, str, length);
+	if(taillength)
+		memcpy(header->data + length, tail, taillength);
+	brt_str_release(var->ptr);
+	var->ptr = header->data;
+}
+
+void brt_str_store(char ** var, char * str)
+{
+	str = brt_str_retain(str);
+	brt_str_release(*var);
+	*var = str;
+}
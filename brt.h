@@ -0,0 +1,138 @@
+#pragma once
+/*
+    BASIC runtime, linked into every compiled program
+    Copyright (C) 2012  microcai <microcai@fedoraproject.org>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include <stddef.h>
+
+#include "qbc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* PRINT #fileno, fmt, ... ; fileno 0 is the screen */
+int brt_print(long fileno, const char * fmt, ...);
+
+/*
+ * resource budget for untrusted programs
+ *
+ * code compiled with budget checks decrements brt_steps on every function
+ * entry and loop back-edge and calls brt_budget_exceeded() once it drops
+ * below zero. brt_malloc and friends replace the C library allocators and
+ * count live heap bytes against the quota, so do strings and arrays.
+ *
+ * onexceeded is called with "step" or "heap" and is expected not to return
+ * (the JIT longjmps back to the host). without it the process exits.
+ * the state is global: one budgeted program at a time per process.
+ */
+extern long long brt_steps;
+
+void brt_budget_start(long long steps, size_t heap, void (*onexceeded)(const char * what));
+/* free what was allocated since brt_budget_start() and is still live (brt_malloc
+   blocks, strings, array storage), lift the limits */
+void brt_budget_stop(void);
+void brt_budget_exceeded(void);
+
+void * brt_malloc(long size);
+void * brt_calloc(long count, long size);
+void brt_free(void * ptr);
+char * brt_strdup(const char * str);
+
+/*
+ * BASIC strings. a string is a char * to NUL terminated characters, so it
+ * goes to printf and the C library unchanged, with this header right in
+ * front of the characters. refcount < 0 marks a constant, which is never
+ * freed. a NULL string is empty.
+ *
+ * a string variable is a struct brt_strvar. strings shorter than
+ * BRT_STR_INLINE are copied into the variable itself: ptr points at data,
+ * and the header right in front of it has refcount 0, so the characters
+ * belong to the variable and are never counted or freed. longer ones are
+ * shared on the heap. a strvar must not be moved, array elements therefore
+ * are a plain char *.
+ *
+ * brt_str_concat() puts the result in tmp, which is a scratch variable of
+ * the caller. a short result stays in tmp, a long one is a new string
+ * holding one reference.
+ * brt_str_retain() returns a string holding one more reference, an inline
+ * one is copied to the heap first.
+ * brt_str_assign() stores str into a variable, brt_str_store() into a
+ * plain char *, both dropping the reference to the old value.
+ * brt_str_append() stores str + tail into a variable, in place when str
+ * is its own value, with room to grow.
+ */
+struct brt_string {
+	long refcount;
+	long length;
+	long capacity; /* room for characters, the NUL not counted */
+	char data[];
+};
+
+#define brt_string_of(str)	((struct brt_string *)(str) - 1)
+
+#define BRT_STR_INLINE	16
+
+/* refcount .. data is laid out as struct brt_string */
+struct brt_strvar {
+	char * ptr;
+	long refcount;
+	long length;
+	long capacity;
+	char data[BRT_STR_INLINE];
+};
+
+long brt_str_len(const char * str);
+char * brt_str_concat(struct brt_strvar * tmp, const char * a, const char * b);
+char * brt_str_retain(char * str);
+void brt_str_release(char * str);
+void brt_str_assign(struct brt_strvar * var, char * str);
+void brt_str_append(struct brt_strvar * var, char * str, const char * tail);
+void brt_str_store(char ** var, char * str);
+
+/*
+ * BASIC arrays. btr_qbarray_at() returns the address of row index (for a
+ * plain array the element) to store to, growing the storage geometrically
+ * when index is past the end. btr_qbarray_cell() returns element column of
+ * that row. btr_qbarray_get() and btr_qbarray_getcell() are the same for
+ * reading: past the end they return the address of a read-only 0.
+ * btr_qbarray_dim() sizes the array for ARRAYDIM a(n, m), rowsize in bytes.
+ */
+void btr_qbarray_new(QBArray * array, long elementsize);
+void * btr_qbarray_at(QBArray * array, long index);
+void * btr_qbarray_cell(QBArray * array, long row, long column);
+void * btr_qbarray_get(QBArray * array, long index);
+void * btr_qbarray_getcell(QBArray * array, long row, long column);
+void btr_qbarray_dim(QBArray * array, long rows, long rowsize);
+void btr_qbarray_free(QBArray * array);
+
+/*
+ * the slow paths of the string and array functions. these allocate and
+ * keep the heap budget, the functions above only call them, so the
+ * functions above can be inlined into compiled code.
+ */
+void brt_abort(const char * msg);
+struct brt_string * brt_str_reserve(long length, long capacity);
+struct brt_string * brt_str_resize(struct brt_string * str, long capacity);
+void brt_str_free(struct brt_string * str);
+void brt_array_grow(QBArray * array, size_t needed);
+void brt_array_free(QBArray * array);
+
+#ifdef __cplusplus
+}
+#endif
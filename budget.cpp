@@ -0,0 +1,107 @@
+/*
+    resource-budgeted execution for untrusted programs
+    Copyright (C) 2012  microcai <microcai@fedoraproject.org>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#include <climits>
+#include <csetjmp>
+#include <cstdio>
+
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Module.h>
+#include <llvm/ExecutionEngine/ExecutionEngine.h>
+
+#include "budget.hpp"
+#include "jit.hpp"
+#include "optimizer.hpp"
+#include "brt.h"
+
+//#define debug	std::printf
+#define debug(...)
+
+namespace qbc{
+
+void addbudgetchecks(llvm::Module * module)
+{
+	llvm::IRBuilder<> builder(module->getContext());
+
+	llvm::GlobalVariable * steps = new llvm::GlobalVariable(*module, builder.getInt64Ty(), false,
+		llvm::GlobalValue::ExternalLinkage, NULL, "brt_steps");
+
+	llvm::Constant * exceeded = module->getOrInsertFunction("brt_budget_exceeded",
+		llvm::FunctionType::get(builder.getVoidTy(), false));
+
+	for(llvm::Function & func : *module)
+	{
+		if(!func.isDeclaration())
+		{
+			// 正常情况下 brt_budget_exceeded 不返回. 返回了 (没有设置回调) 就继续跑, 由 brt 决定怎么收场.
+			addcounterchecks(&func, steps, -1, llvm::CmpInst::ICMP_SLT, 0, exceeded, {}, "budget");
+		}
+	}
+}
+
+void addquotasymbols(RuntimeMemoryManager * mm)
+{
+	mm->addsymbol("malloc", (void*) &::brt_malloc);
+	mm->addsymbol("calloc", (void*) &::brt_calloc);
+	mm->addsymbol("free", (void*) &::brt_free);
+	mm->addsymbol("strdup", (void*) &::brt_strdup);
+}
+
+static jmp_buf budgetjmp;
+static const char * budgetwhat;
+
+static void budgetexceeded(const char * what)
+{
+	budgetwhat = what;
+	std::longjmp(budgetjmp, 1);
+}
+
+int runbudgeted(llvm::ExecutionEngine * engine, const Budget & budget, std::string & err)
+{
+	uint64_t mainaddr = engine->getFunctionAddress("main");
+
+	if(!mainaddr){
+		err = "no main() in program";
+		return -1;
+	}
+
+	engine->runStaticConstructorsDestructors(false);
+
+	brt_budget_start(budget.steps && budget.steps < (uint64_t) LLONG_MAX ? (long long) budget.steps : LLONG_MAX,
+					 budget.heap && budget.heap < SIZE_MAX ? (size_t) budget.heap : SIZE_MAX, &budgetexceeded);
+
+	// JIT 出来的代码没有需要析构的东西, 直接 longjmp 跳过它们的栈帧是安全的.
+	volatile int ret = -1;
+
+	if(setjmp(budgetjmp) == 0){
+		ret = ((int (*)()) mainaddr)();
+	}else{
+		debug("%s budget exceeded\n", budgetwhat);
+		err = std::string(budgetwhat) + " budget exceeded";
+	}
+
+	std::fflush(stdout);
+	brt_budget_stop();
+
+	engine->runStaticConstructorsDestructors(true);
+	return ret;
+}
+
+}
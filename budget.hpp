@@ -0,0 +1,56 @@
+/*
+    resource-budgeted execution for untrusted programs
+    Copyright (C) 2012  microcai <microcai@fedoraproject.org>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace llvm{
+class Module;
+class ExecutionEngine;
+}
+
+namespace qbc{
+
+class RuntimeMemoryManager;
+
+// 不可信的程序: 函数入口和循环回边各算一步, 活着的堆内存按字节算.
+struct Budget
+{
+	Budget() : steps(0), heap(0) {}
+
+	uint64_t	steps;	// 0 不限
+	uint64_t	heap;	// 字节, 0 不限
+};
+
+// 在所有函数的入口和循环回边上插入:
+//   brt_steps -= 1; if(brt_steps < 0) brt_budget_exceeded();
+// 要在优化之前调用, 循环还没被改写.
+void addbudgetchecks(llvm::Module * module);
+
+// 生成代码里的 malloc/calloc/free/strdup 改用 brt 里计配额的版本.
+void addquotasymbols(RuntimeMemoryManager * mm);
+
+// 在预算内执行 main (必须先经过 wrapmain), 结束后释放程序没释放的内存 (malloc 的, 字符串和数组).
+// 程序的全局变量之后不能再读, 再跑一次的时候由 DIM 重新初始化.
+// 超出预算的时候生成的代码被 longjmp 打断, 返回 -1, 原因放在 err.
+// 同一时间一个进程里只能有一个在跑.
+int runbudgeted(llvm::ExecutionEngine * engine, const Budget & budget, std::string & err);
+
+}
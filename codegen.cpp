@@ -37,6 +37,22 @@
 //#define debug	std::printf
 #define debug(...)
 
+// 释放语句里生成的临时字符串. 语句已经跳走了的话, 放在跳转前面.
+static void releasetemps(ASTContext ctx, std::vector<llvm::Value*> & temps)
+{
+    if(temps.empty()) // 函数定义之类的语句, ctx.block 可能是 NULL
+	return;
+
+    llvm::IRBuilder<> builder(ctx.block);
+
+    if(ctx.block->getTerminator())
+	builder.SetInsertPoint(ctx.block->getTerminator());
+
+    for(llvm::Value * temp : temps)
+	builder.CreateCall(qbc::getbuiltinprotype(ctx,"brt_str_release"), temp);
+    temps.clear();
+}
+
 llvm::BasicBlock* EmptyStmtAST::Codegen(ASTContext ctx)
 {
     debug("empty statement called !\n");
@@ -121,7 +137,7 @@ llvm::BasicBlock* PrintStmtAST::Codegen(ASTContext ctx)
     // builder.CreateCondBr();
     // 调用 print.
     if(need_brt){
-	args.insert(args.begin(), qbc::getconstint(0) );
+	args.insert(args.begin(), qbc::getconstint(ctx, 0) );
 
 	llvm::Constant *brt_print =qbc::getbuiltinprotype(ctx,"brt_print");
 
@@ -144,6 +160,16 @@ llvm::BasicBlock* PrintStmtAST::Codegen(ASTContext ctx)
 llvm::Value* VariableDimAST::getptr(ASTContext ctx)
 {
     debug("get ptr of this alloca %p\n", alloca_var);
+
+    // 在之前的 module 里定义的全局变量 (REPL), 在当前 module 里声明一下.
+    // 字符串变量外面还有一层 bitcast.
+    llvm::GlobalVariable * global = alloca_var ?
+	llvm::dyn_cast<llvm::GlobalVariable>(alloca_var->stripPointerCasts()) : NULL;
+    if(global && global->getParent() != ctx.module)
+	return llvm::ConstantExpr::getBitCast(
+	    ctx.module->getOrInsertGlobal(global->getName(), global->getType()->getElementType()),
+	    alloca_var->getType());
+
     return alloca_var;
 }
 
@@ -153,13 +179,6 @@ llvm::Value* VariableDimAST::getval(ASTContext ctx)
     llvm::IRBuilder<> builder(ctx.block);
 
     return builder.CreateLoad(getptr(ctx));
-
-#ifdef WIN32
-    printf("%s\n", __FUNCTION__);
-#else
-    printf("%s\n", __func__);
-#endif
-    exit(1);
 }
 
 // 为变量分配空间.
@@ -172,7 +191,12 @@ llvm::BasicBlock* VariableDimAST::Codegen(ASTContext ctx)
 
     debug("allocate stack for var %s , type %s\n", name.c_str(), type->name(ctx).c_str());
 
-    alloca_var = exptype->Alloca(ctx,this->name);
+    if(ctx.codeblock->globalscope)
+	alloca_var = exptype->GlobalAlloca(ctx, "qbc.global." + this->name);
+    else
+	alloca_var = exptype->Alloca(ctx,this->name);
+
+    exptype->dimension(ctx, alloca_var, ctx.codeblock->globalscope, extents);
 
     // register with symbolic table
     ctx.codeblock->symbols.insert(std::make_pair(this->name,this));
@@ -224,7 +248,8 @@ llvm::Value* ArgumentDimAST::getval(ASTContext ctx)
 	    return arg_it;
     }
     debug("bug here %s \n",__FUNCTION__);
-    exit(1);
+    ctx.error("argument " + this->name + " not found");
+    return qbc::getconstlong(ctx, 0);
 }
 
 llvm::Value* ArgumentDimAST::getptr(ASTContext ctx)
@@ -258,6 +283,10 @@ llvm::BasicBlock* ArgumentDimAST::Codegen(ASTContext ctx)
 
 llvm::Value* FunctionDimAST::getptr(ASTContext ctx)
 {
+    // 在之前的 module 里定义的 (REPL), 在当前 module 里声明一下.
+    if(target && target->getParent() != ctx.module)
+	return ctx.module->getOrInsertFunction(target->getName(), target->getFunctionType());
+
     return this->target;
 }
 
@@ -269,9 +298,14 @@ llvm::Value* FunctionDimAST::setret(ASTContext ctx,ExprASTPtr expr)
     if(!retval)
 	retval = static_cast<CallableExprTypeAST*>(type.get())->returntype->Alloca(ctx,"return value");
 
-    llvm::Value* ret = expr->getval(ctx);
+    std::vector<llvm::Value*> temps;
+    ctx.temps = &temps;
+
+    // 调用者拿到的返回值要多一个引用, 函数里的变量马上就要撤销了.
+    llvm::Value* ret = static_cast<CallableExprTypeAST*>(type.get())->returntype->retain(ctx, expr->getval(ctx));
 
     builder.CreateStore(ret,ctx.func->retval);
+    releasetemps(ctx, temps);
 
     if(!returnblock)
 	returnblock = llvm::BasicBlock::Create(ctx.module->getContext(), "ret",this->target);
@@ -317,30 +351,34 @@ llvm::BasicBlock* IFStmtAST::Codegen(ASTContext ctx)
 
     llvm::IRBuilder<> builder(ctx.block);
 
+    std::vector<llvm::Value*> temps;
+    ctx.temps = &temps;
+
     llvm::Value * expcond = this->_expr->getval(ctx);
 
-    expcond = builder.CreateIntCast(expcond,qbc::getbooltype(),1);
+    expcond = builder.CreateIntCast(expcond,qbc::getbooltype(ctx),1);
 
-    expcond = builder.CreateICmpNE(expcond, qbc::getconstfalse(), "tmp");
+    expcond = builder.CreateICmpNE(expcond, qbc::getconstfalse(ctx), "tmp");
+    releasetemps(ctx, temps);
     builder.CreateCondBr(expcond, cond_true, cond_false);
 
     // generating true
     ctx.block = cond_true;
 
     this->_then->parent = ctx.codeblock;// NOTE important
-    this->_then->Codegen(ctx);
-    builder.SetInsertPoint(cond_true);
-    builder.CreateBr(cond_continue);
+    // RETURN 已经生成了跳转, 不能再加一个.
+    builder.SetInsertPoint(this->_then->Codegen(ctx));
+    if(!builder.GetInsertBlock()->getTerminator())
+	builder.CreateBr(cond_continue);
 
     // generating false , if there is any
     if( this->_else){
 	this->_else->parent = ctx.codeblock;// NOTE important
 	ctx.block = cond_false;
-	this->_else->Codegen(ctx);
-	builder.SetInsertPoint(cond_false);
-	builder.CreateBr(cond_continue);
+	builder.SetInsertPoint(this->_else->Codegen(ctx));
+	if(!builder.GetInsertBlock()->getTerminator())
+	    builder.CreateBr(cond_continue);
     }
-    builder.CreateBr(cond_continue);
     return cond_continue;
 }
 
@@ -373,9 +411,15 @@ llvm::BasicBlock* WhileLoopAST::Codegen(ASTContext ctx)
 
     builder.SetInsertPoint(cond_while);
     ctx.block = cond_while;
+
+    // 条件里的临时字符串每次判断完就释放.
+    std::vector<llvm::Value*> temps;
+    ctx.temps = &temps;
+
     llvm::Value * expcond = this->condition->getval(ctx);
-    expcond = builder.CreateIntCast(expcond,qbc::getbooltype(),true);
-    expcond = builder.CreateICmpEQ(expcond, qbc::getconstfalse(), "tmp");
+    expcond = builder.CreateIntCast(expcond,qbc::getbooltype(ctx),true);
+    expcond = builder.CreateICmpEQ(expcond, qbc::getconstfalse(ctx), "tmp");
+    releasetemps(ctx, temps);
     builder.CreateCondBr(expcond, cond_continue, while_body);
 
     ctx.block = while_body;
@@ -410,7 +454,7 @@ llvm::BasicBlock* ForLoopAST::Codegen(ASTContext ctx)
     // 测试条件是否成立.
     llvm::Value * condval = exprtype->getop()->operator_comp(ctx,OPERATOR_LESSEQU,refID,end)->getval(ctx);
 
-    condval = builder.CreateIntCast(condval,qbc::getbooltype(),1);
+    condval = builder.CreateIntCast(condval,qbc::getbooltype(ctx),1);
     builder.CreateCondBr(condval,for_body,for_out);
 
     ctx.block = for_body;
@@ -443,10 +487,14 @@ llvm::BasicBlock* CodeBlockAST::Codegen(ASTContext ctx)
 
     ctx.codeblock = this;
 
+    std::vector<llvm::Value*> temps;
+    ctx.temps = &temps;
+
     for(auto stmt : statements)
     {
 	if(stmt){
 	    ctx.block =  stmt->Codegen(ctx);
+	    releasetemps(ctx, temps);
 	}
 	else
 	    debug("strange, stmt is null\n");
@@ -469,19 +517,9 @@ llvm::BasicBlock* CodeBlockAST::GenLeave(ASTContext ctx)
     return ctx.block;
 }
 
-// 生成函数 参数和反回值支持.
-llvm::BasicBlock* FunctionDimAST::Codegen(ASTContext ctx)
+llvm::FunctionType* FunctionDimAST::functype(ASTContext ctx)
 {
-    assert(!ctx.llvmfunc);
-    assert(!ctx.block);
-
-    ctx.func = this; // 设定当前函数.
-    llvm::BasicBlock * blockforret = ctx.block;
-
-    debug("generating function %s and its body now\n", this->name.c_str());
-
-    //首先生成全局可用的外部辅助函数.
-    llvm::IRBuilder<> builder(llvm::getGlobalContext());
+    llvm::IRBuilder<> builder(ctx.module->getContext());
 
     // 参数生成 args
     //为 ARG 生成代码!.
@@ -502,11 +540,41 @@ llvm::BasicBlock* FunctionDimAST::Codegen(ASTContext ctx)
     }
 
     //函数返回类型.
-    llvm::FunctionType *funcType =
-	llvm::FunctionType::get(type ? type->llvm_type(ctx) : builder.getVoidTy(),args,true);
+    return llvm::FunctionType::get(type ? type->llvm_type(ctx) : builder.getVoidTy(),args,true);
+}
+
+llvm::BasicBlock* FunctionDimAST::declare(ASTContext ctx)
+{
+    debug("declaring external function %s\n", this->name.c_str());
+
+    target = llvm::Function::Create(functype(ctx), llvm::Function::ExternalLinkage, this->name , ctx.module);
+
+    ctx.codeblock->symbols.insert(std::make_pair(this->name,this));
+    return ctx.block;
+}
+
+// 生成函数 参数和反回值支持.
+llvm::BasicBlock* FunctionDimAST::Codegen(ASTContext ctx)
+{
+    assert(!ctx.llvmfunc);
+    assert(!ctx.block);
+
+    ctx.func = this; // 设定当前函数.
+    llvm::BasicBlock * blockforret = ctx.block;
+
+    debug("generating function %s and its body now\n", this->name.c_str());
+
+    //首先生成全局可用的外部辅助函数.
+    llvm::IRBuilder<> builder(ctx.module->getContext());
+
+    llvm::FunctionType *funcType = functype(ctx);
+
+    // 没有 EXPORT 的函数只在本文件里用, internal 的才能放心内联和删除. main 是入口, 总要导出.
+    llvm::GlobalValue::LinkageTypes linkage = (this->linkage == STATIC && this->name != "main")
+	? llvm::Function::InternalLinkage : llvm::Function::ExternalLinkage;
 
     target = ctx.llvmfunc =
-	llvm::Function::Create(funcType, llvm::Function::ExternalLinkage, this->name , ctx.module);
+	llvm::Function::Create(funcType, linkage, this->name , ctx.module);
 
     llvm::BasicBlock *entry = llvm::BasicBlock::Create(builder.getContext(), "entrypoint", ctx.llvmfunc);
 
@@ -535,7 +603,9 @@ llvm::BasicBlock* FunctionDimAST::Codegen(ASTContext ctx)
     ctx.block = bodyblock;
 
     if(returnblock){
-	builder.CreateBr(returnblock);
+	builder.SetInsertPoint(bodyblock);
+	if(!bodyblock->getTerminator())
+	    builder.CreateBr(returnblock);
 	returnblock->moveAfter(bodyblock);
 	builder.SetInsertPoint(returnblock);
 	ctx.block = returnblock;
@@ -547,8 +617,8 @@ llvm::BasicBlock* FunctionDimAST::Codegen(ASTContext ctx)
 
     if(retval)
 	builder.CreateRet(builder.CreateLoad(retval));
-    else if(type)
-	builder.CreateRet(qbc::getconstlong(0)); // 返回 0.
+    else if(!funcType->getReturnType()->isVoidTy())
+	builder.CreateRet(qbc::getconstlong(ctx, 0)); // 返回 0.
     else
 	builder.CreateRetVoid();
     return blockforret;
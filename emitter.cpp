@@ -0,0 +1,210 @@
+/*
+    ahead-of-time emission of native objects and executables
+    Copyright (C) 2012  microcai <microcai@fedoraproject.org>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include <cstdlib>
+#include <memory>
+
+#include <llvm/CodeGen/ParallelCG.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/LegacyPassManager.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Host.h>
+#include <llvm/Support/TargetRegistry.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Target/TargetOptions.h>
+
+#include "emitter.hpp"
+#include "optimizer.hpp"
+
+#ifndef BRT_LIBRARY_DIR
+#define BRT_LIBRARY_DIR "."
+#endif
+
+//#define debug	std::printf
+#define debug(...)
+
+namespace qbc{
+
+llvm::TargetMachine * createtargetmachine(unsigned optlevel, std::string & err)
+{
+	std::string triple = llvm::sys::getDefaultTargetTriple();
+
+	const llvm::Target * target = llvm::TargetRegistry::lookupTarget(triple, err);
+	if(!target)
+		return NULL;
+
+	llvm::TargetOptions options;
+
+	// PIC 这样也能链接成 PIE.
+	return target->createTargetMachine(triple, llvm::sys::getHostCPUName(), "", options,
+									   llvm::Reloc::PIC_, llvm::CodeModel::Default,
+									   codegenoptlevel(optlevel));
+}
+
+llvm::TargetMachine * cachedtargetmachine(unsigned optlevel, std::string & err)
+{
+	static std::unique_ptr<llvm::TargetMachine> machines[4];
+
+	if(optlevel > 3)
+		optlevel = 3;
+
+	if(!machines[optlevel])
+		machines[optlevel].reset(createtargetmachine(optlevel, err));
+	return machines[optlevel].get();
+}
+
+void wrapmain(llvm::Module * module)
+{
+	llvm::Function * basicmain = module->getFunction("main");
+
+	if(!basicmain || !basicmain->getReturnType()->isVoidTy())
+		return;
+
+	basicmain->setName("__qbc_main");
+
+	llvm::IRBuilder<> builder(module->getContext());
+
+	llvm::Function * cmain = llvm::Function::Create(
+		llvm::FunctionType::get(builder.getInt32Ty(), false), llvm::Function::ExternalLinkage, "main", module);
+
+	builder.SetInsertPoint(llvm::BasicBlock::Create(module->getContext(), "entrypoint", cmain));
+	builder.CreateCall(basicmain, {});
+	builder.CreateRet(builder.getInt32(0));
+}
+
+bool emitobject(llvm::Module * module, llvm::TargetMachine * tm, const std::string & path, std::string & err)
+{
+	module->setTargetTriple(tm->getTargetTriple().str());
+	module->setDataLayout(tm->createDataLayout());
+
+	std::error_code ec;
+	llvm::raw_fd_ostream out(path, ec, llvm::sys::fs::F_None);
+
+	if(ec){
+		err = ec.message();
+		return false;
+	}
+
+	llvm::legacy::PassManager pm;
+
+	if(tm->addPassesToEmitFile(pm, out, llvm::TargetMachine::CGFT_ObjectFile)){
+		err = "target can't emit object file";
+		return false;
+	}
+
+	pm.run(*module);
+	out.flush();
+	return true;
+}
+
+bool emitobjects(llvm::Module * module, unsigned optlevel, unsigned jobs, const std::string & stem,
+				 std::vector<std::string> & objects, std::string & err)
+{
+	std::unique_ptr<llvm::Module> owner(module);
+
+	module->setTargetTriple(llvm::sys::getDefaultTargetTriple());
+
+	std::vector<std::unique_ptr<llvm::raw_fd_ostream>> streams;
+	std::vector<llvm::raw_pwrite_stream*> outs;
+
+	for(unsigned i = 0; i < jobs; i++)
+	{
+		std::string path = stem + ".part" + std::to_string(i) + ".o";
+		std::error_code ec;
+
+		streams.emplace_back(new llvm::raw_fd_ostream(path, ec, llvm::sys::fs::F_None));
+		if(ec){
+			err = path + ": " + ec.message();
+			return false;
+		}
+		objects.push_back(path);
+		outs.push_back(streams.back().get());
+	}
+
+	// SplitModule 按函数把 module 分成 jobs 份, 每份在自己的线程和 LLVMContext 里生成代码.
+	// 私有的符号会被改成外部可见, 链接时才能互相引用.
+	llvm::splitCodeGen(std::move(owner), outs, llvm::sys::getHostCPUName(), "", llvm::TargetOptions(),
+					   llvm::Reloc::PIC_, llvm::CodeModel::Default, codegenoptlevel(optlevel));
+	return true;
+}
+
+static std::string shellquote(const std::string & arg)
+{
+	std::string quoted = "'";
+	for(char c : arg)
+	{
+		if(c == '\'')
+			quoted += "'\\''";
+		else
+			quoted += c;
+	}
+	return quoted + "'";
+}
+
+bool linkexecutable(const std::vector<std::string> & objects, const std::string & output, std::string & err)
+{
+	const char * cc = std::getenv("CC");
+
+	std::string cmdline = cc ? cc : "cc";
+
+	cmdline += " -o " + shellquote(output);
+
+	for(const std::string & obj : objects)
+		cmdline += " " + shellquote(obj);
+
+	cmdline += " " + shellquote(std::string(BRT_LIBRARY_DIR) + "/libbrtlean.a");
+
+	// 静态链接, 启动的时候不用动态加载器. 没有静态的 libc 就退回动态链接.
+	std::string staticcmd = cmdline + " -static 2>/dev/null";
+
+	debug("linking: %s\n", staticcmd.c_str());
+
+	if(std::system(staticcmd.c_str()) == 0)
+		return true;
+
+	debug("linking: %s\n", cmdline.c_str());
+
+	if(std::system(cmdline.c_str()) != 0){
+		err = "link failed: " + cmdline;
+		return false;
+	}
+	return true;
+}
+
+bool linkrelocatable(const std::vector<std::string> & objects, const std::string & output, std::string & err)
+{
+	const char * cc = std::getenv("CC");
+
+	std::string cmdline = cc ? cc : "cc";
+
+	cmdline += " -r -nostdlib -o " + shellquote(output);
+
+	for(const std::string & obj : objects)
+		cmdline += " " + shellquote(obj);
+
+	debug("linking: %s\n", cmdline.c_str());
+
+	if(std::system(cmdline.c_str()) != 0){
+		err = "link failed: " + cmdline;
+		return false;
+	}
+	return true;
+}
+
+}
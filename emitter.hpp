@@ -0,0 +1,54 @@
+/*
+    ahead-of-time emission of native objects and executables
+    Copyright (C) 2012  microcai <microcai@fedoraproject.org>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <llvm/IR/Module.h>
+#include <llvm/Target/TargetMachine.h>
+
+namespace qbc{
+
+// 为本机创建 TargetMachine. 失败返回 NULL, 错误信息放在 err.
+llvm::TargetMachine * createtargetmachine(unsigned optlevel, std::string & err);
+
+// 每个优化级别只创建一次, 进程内一直复用, 调用者不要 delete. 不是线程安全的.
+llvm::TargetMachine * cachedtargetmachine(unsigned optlevel, std::string & err);
+
+// SUB main 没有返回值, 不能直接当 C 的 main 用.
+// 把它改名, 再包一个返回 0 的 int main().
+void wrapmain(llvm::Module * module);
+
+// 生成 .o 文件.
+bool emitobject(llvm::Module * module, llvm::TargetMachine * tm, const std::string & path, std::string & err);
+
+// 按函数把 module 拆成 jobs 份, 在 jobs 个线程里并行生成 stem.partN.o, 文件名放进 objects.
+// 接管 module.
+bool emitobjects(llvm::Module * module, unsigned optlevel, unsigned jobs, const std::string & stem,
+				 std::vector<std::string> & objects, std::string & err);
+
+// 用系统的 cc 把目标文件和精简的 BASIC 运行时 (libbrtlean.a) 链接成可执行文件.
+// 优先静态链接, 不行再动态链接.
+bool linkexecutable(const std::vector<std::string> & objects, const std::string & output, std::string & err);
+
+// 把多个 .o 合并成一个可重定位的 .o (cc -r).
+bool linkrelocatable(const std::vector<std::string> & objects, const std::string & output, std::string & err);
+
+}
@@ -0,0 +1,193 @@
+/*
+    reentrant entry point of the QBASIC frontend
+    Copyright (C) 2012  microcai <microcai@fedoraproject.org>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include <algorithm>
+
+#include <llvm/IR/Verifier.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include "ast.hpp"
+#include "parser.hpp"
+#include "frontend.hpp"
+
+// qblex.cpp 里的可重入接口, flex 没有生成头文件.
+int yylex_init(void ** scanner);
+int yylex_destroy(void * scanner);
+void yyset_in(FILE * in, void * scanner);
+void yyset_lineno(int line, void * scanner);
+
+namespace qbc{
+
+ParseState::ParseState()
+	: program(0)
+	, useDefautSubMain(true)
+	, in_loop(0)
+	, continue_corrections(0)
+	, unclosed_dos(0)
+	, unclosed_fors(0)
+	, unclosed_ifs(0)
+	, unclosed_repeats(0)
+	, unclosed_subs(0)
+	, unclosed_switches(0)
+	, unclosed_whiles(0)
+{
+}
+
+bool parse(FILE * file, ParseState & state)
+{
+	void * scanner;
+
+	if(yylex_init(&scanner)){
+		state.error = "failed to create scanner";
+		return false;
+	}
+	yyset_in(file, scanner);
+	yyset_lineno(1, scanner);
+
+	qb::parser parser(state, scanner);
+	int ret = parser.parse();
+
+	yylex_destroy(scanner);
+
+	if(ret || !state.program){
+		if(state.error.empty())
+			state.error = "syntax error";
+		return false;
+	}
+	return true;
+}
+
+StatementAST * parse(FILE * file, std::string & err)
+{
+	ParseState state;
+
+	if(!parse(file, state)){
+		err = state.error;
+		return NULL;
+	}
+	return state.program;
+}
+
+bool generate(StatementAST * program, llvm::Module * module, std::string & err)
+{
+	std::string errors;
+
+	ASTContext ctx;
+	ctx.module = module;
+	ctx.errors = &errors;
+
+	CodeBlockAST gloablblock;
+	ctx.codeblock = &gloablblock;
+
+	program->Codegen(ctx);
+
+	if(!errors.empty()){
+		err = errors;
+		return false;
+	}
+	return true;
+}
+
+static llvm::Module * compile(FILE * file, llvm::LLVMContext & context,
+							  const std::string & name, std::string & err)
+{
+	StatementAST * program = parse(file, err);
+	std::fclose(file);
+
+	if(!program)
+		return NULL;
+
+	llvm::Module * module = new llvm::Module(name, context);
+	if(!generate(program, module, err)){
+		delete module;
+		return NULL;
+	}
+
+	llvm::raw_string_ostream os(err);
+	if(llvm::verifyModule(*module, &os)){
+		os.flush();
+		delete module;
+		return NULL;
+	}
+	return module;
+}
+
+llvm::Module * compile(const std::string & path, llvm::LLVMContext & context,
+					   const std::string & name, std::string & err)
+{
+	FILE * file = std::fopen(path.c_str(), "r");
+
+	if(!file){
+		err = "open " + path + " failed!";
+		return NULL;
+	}
+	return compile(file, context, name, err);
+}
+
+llvm::Module * compilesource(const std::string & source, llvm::LLVMContext & context,
+							 const std::string & name, std::string & err)
+{
+	// 词法分析器只认 FILE*, 用 fmemopen 包一下.
+	FILE * file = fmemopen((void*) source.data(), source.size(), "r");
+
+	if(!file){
+		err = "fmemopen failed";
+		return NULL;
+	}
+	return compile(file, context, name, err);
+}
+
+bool functionsources(const std::string & source, std::map<std::string, std::string> & sources, std::string & err)
+{
+	FILE * file = fmemopen((void*) source.data(), source.size(), "r");
+
+	if(!file){
+		err = "fmemopen failed";
+		return false;
+	}
+
+	ParseState state;
+	bool ok = parse(file, state);
+	std::fclose(file);
+
+	if(!ok){
+		err = state.error;
+		return false;
+	}
+
+	// 行号从 1 开始, lines[i] 是第 i 行开头的偏移.
+	std::vector<size_t> lines(2, 0);
+	for(size_t i = 0; i < source.size(); i++)
+	{
+		if(source[i] == '\n')
+			lines.push_back(i + 1);
+	}
+	lines.push_back(source.size());
+
+	for(FunctionDimAST * func : state.functions)
+	{
+		size_t first = std::min<size_t>(func->firstline, lines.size() - 1);
+		size_t last = std::min<size_t>(func->lastline + 1, lines.size() - 1);
+
+		sources[func->name] = source.substr(lines[first], lines[last] - lines[first]);
+	}
+	return true;
+}
+
+}
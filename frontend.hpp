@@ -0,0 +1,79 @@
+/*
+    reentrant entry point of the QBASIC frontend
+    Copyright (C) 2012  microcai <microcai@fedoraproject.org>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+#pragma once
+
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+
+class StatementAST;
+class FunctionDimAST;
+
+namespace qbc{
+
+// 一次解析的全部状态, 原来都是 parser.ypp 里的全局变量.
+// 每次 parse() 一份, 词法分析器也是可重入的, 所以可以多个线程同时解析.
+struct ParseState
+{
+	ParseState();
+
+	StatementAST *	program;
+	bool	useDefautSubMain;	/* shall we treat the while file as an sub main ? */
+
+	int in_loop;                /* in loop? */
+	int continue_corrections;   /* continue corrections */
+	int unclosed_dos;           /* unclosed "if" count */
+	int unclosed_fors;          /* unclosed "for" count */
+	int unclosed_ifs;           /* unclosed "if" count */
+	int unclosed_repeats;       /* unclosed "repeat" count */
+	int unclosed_subs;          /* unclosed subroutine count */
+	int unclosed_switches;      /* unclosed "switch" count */
+	int unclosed_whiles;        /* unclosed "while" count */
+
+	std::vector<FunctionDimAST*>	functions;	// 定义的 FUNCTION/SUB, 多文件工程用来找导出的函数
+	std::string	error;			// 语法错误信息
+};
+
+// 解析 file, 结果和错误信息都在 state 里.
+bool parse(FILE * file, ParseState & state);
+
+// 解析 file. 出错返回 NULL, 错误信息放在 err.
+StatementAST * parse(FILE * file, std::string & err);
+
+// 为 program 生成代码, 放进 module. 源码有错 (比如用了没定义的变量) 返回 false,
+// 错误信息放在 err, module 里的东西不能用.
+bool generate(StatementAST * program, llvm::Module * module, std::string & err);
+
+// 解析 path 并在 context 里生成名为 name 的 module, 失败返回 NULL.
+// 不碰任何全局状态, 每个线程用自己的 LLVMContext 就可以并发编译.
+llvm::Module * compile(const std::string & path, llvm::LLVMContext & context,
+					   const std::string & name, std::string & err);
+
+// 同 compile, 源码直接在内存里.
+llvm::Module * compilesource(const std::string & source, llvm::LLVMContext & context,
+							 const std::string & name, std::string & err);
+
+// 每个 FUNCTION/SUB 从开头到 END 的源码, 按函数名. 热重载拿它判断函数有没有改过.
+bool functionsources(const std::string & source, std::map<std::string, std::string> & sources, std::string & err);
+
+}
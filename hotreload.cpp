@@ -0,0 +1,249 @@
+/*
+    hot reload: recompile changed FUNCTIONs into a running program
+    Copyright (C) 2012  microcai <microcai@fedoraproject.org>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include <sys/stat.h>
+
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include "emitter.hpp"
+#include "frontend.hpp"
+#include "hotreload.hpp"
+#include "optimizer.hpp"
+
+//#define debug	std::printf
+#define debug(...)
+
+namespace qbc{
+
+static FileStamp filestamp(const std::string & path)
+{
+	struct stat st;
+	FileStamp stamp = {0, 0, 0};
+
+	if(::stat(path.c_str(), &st) < 0)
+		return stamp;
+
+	stamp.sec = st.st_mtim.tv_sec;
+	stamp.nsec = st.st_mtim.tv_nsec;
+	stamp.size = st.st_size;
+	return stamp;
+}
+
+// 读源文件并取出每个函数的源码. 函数的源码没变就不用重新编译, 挪了位置也不算变.
+static bool readsources(const std::string & path, std::string & source,
+						std::map<std::string, std::string> & sources, std::string & err)
+{
+	llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer = llvm::MemoryBuffer::getFile(path);
+
+	if(!buffer){
+		err = "open " + path + " failed!";
+		return false;
+	}
+
+	source = (*buffer)->getBuffer();
+	return functionsources(source, sources, err);
+}
+
+// main 一直在栈上跑, 换不了.
+static bool reloadable(llvm::Function & func)
+{
+	return !func.isDeclaration() && func.getName() != "main" && func.getName() != "__qbc_main";
+}
+
+ReloadJIT::ReloadJIT(llvm::LLVMContext & _context, const std::string & _path, unsigned optlevel, unsigned _interval)
+	: LazyJIT(optlevel)
+	, context(_context)
+	, path(_path)
+	, interval(_interval)
+	, generation(0)
+	, stamp(filestamp(_path))
+	, stopping(false)
+{
+	// 递归调用也走桩, 深递归的函数也能换成新代码.
+	directrecursion = false;
+}
+
+ReloadJIT::~ReloadJIT()
+{
+	{
+		std::lock_guard<std::mutex> guard(watchlock);
+		stopping = true;
+	}
+	watchcond.notify_all();
+
+	if(watcher.joinable())
+		watcher.join();
+}
+
+ReloadJIT * ReloadJIT::create(llvm::Module * module, const std::string & path, unsigned optlevel,
+							  unsigned interval, std::string & err)
+{
+	std::unique_ptr<ReloadJIT> jit(new ReloadJIT(module->getContext(), path, optlevel, interval));
+
+	std::string source;
+	std::map<std::string, std::string> sources;
+
+	if(!readsources(path, source, sources, err))
+		return NULL;
+
+	for(llvm::Function & func : *module)
+	{
+		if(!reloadable(func))
+			continue;
+
+		jit->fingerprints[func.getName()] = sources[func.getName()];
+		jit->signatures[func.getName()] = func.getFunctionType();
+	}
+
+	if(!jit->split(module, err))
+		return NULL;
+
+	jit->watcher = std::thread(&ReloadJIT::watchloop, jit.get());
+	return jit.release();
+}
+
+std::vector<llvm::Function*> ReloadJIT::changed(llvm::Module * module, const std::map<std::string, std::string> & sources)
+{
+	std::vector<llvm::Function*> funcs;
+
+	for(llvm::Function & func : *module)
+	{
+		if(!reloadable(func))
+			continue;
+
+		std::string name = func.getName();
+		std::map<std::string, std::string>::iterator it = fingerprints.find(name);
+
+		// 桩是启动时一次生成的, 新函数没有桩可以改.
+		if(it == fingerprints.end()){
+			llvm::errs() << path << ": " << name << " is new, restart to use it\n";
+			continue;
+		}
+
+		if(signatures[name] != func.getFunctionType()){
+			llvm::errs() << path << ": " << name << " changed its signature, restart to use it\n";
+			continue;
+		}
+
+		std::map<std::string, std::string>::const_iterator text = sources.find(name);
+
+		if(text == sources.end() || it->second == text->second)
+			continue;
+
+		funcs.push_back(&func);
+	}
+	return funcs;
+}
+
+bool ReloadJIT::patch(llvm::Function * func)
+{
+	std::string name = func->getName();
+	llvm::Module * module = extractfunction(func, directrecursion);
+
+	// 还没被调用过, 换掉待编译的那份就行.
+	std::map<std::string, llvm::Module*>::iterator it = pending.find(name);
+
+	if(it != pending.end()){
+		delete it->second;
+		it->second = module;
+		return true;
+	}
+
+	// 和已经编译过的 foo.body 区分开.
+	std::string version = name + ".v" + std::to_string(generation);
+	module->getFunction(name + bodysuffix)->setName(version);
+
+	module->setDataLayout(engine->getDataLayout());
+	optimize(module, optlevel, engine->getTargetMachine());
+	engine->addModule(std::unique_ptr<llvm::Module>(module));
+
+	uint64_t addr = engine->getFunctionAddress(version);
+	uint64_t slot = engine->getGlobalValueAddress(name + ".lazyptr");
+
+	if(!addr || !slot){
+		llvm::errs() << path << ": failed to compile " << name << "\n";
+		return false;
+	}
+
+	// 桩每次调用都重新读 lazyptr, 正在执行的旧代码跑完当前调用后就切换过去.
+	reinterpret_cast<std::atomic<uint64_t>*>(slot)->store(addr, std::memory_order_release);
+
+	llvm::errs() << path << ": reloaded " << name << "\n";
+	return true;
+}
+
+void ReloadJIT::reload()
+{
+	// LLVMContext 不是线程安全的, 和第一次调用时的编译互斥.
+	std::lock_guard<std::recursive_mutex> guard(lock);
+
+	std::string err;
+	std::string source;
+	std::map<std::string, std::string> sources;
+	std::unique_ptr<llvm::Module> module;
+
+	// 源码只读一次, 指纹和生成的代码对应同一份内容.
+	if(readsources(path, source, sources, err))
+		module.reset(qbc::compilesource(source, context, path, err));
+
+	// 改到一半的文件多半通不过, 继续跑旧代码, 等下次保存.
+	if(!module){
+		llvm::errs() << path << ": " << err << "\n";
+		return;
+	}
+
+	wrapmain(module.get());
+	generation++;
+
+	for(llvm::Function * func : changed(module.get(), sources))
+	{
+		std::string name = func->getName();
+
+		// 换上了才记下新源码, 没换上的下次还算有变化.
+		if(patch(func))
+			fingerprints[name] = sources[name];
+	}
+}
+
+void ReloadJIT::watchloop()
+{
+	std::unique_lock<std::mutex> guard(watchlock);
+
+	while(!watchcond.wait_for(guard, std::chrono::milliseconds(interval), [this]{ return stopping; }))
+	{
+		FileStamp now = filestamp(path);
+
+		if(now == stamp)
+			continue;
+
+		debug("%s changed, reloading\n", path.c_str());
+
+		stamp = now;
+		reload();
+	}
+}
+
+}
@@ -0,0 +1,78 @@
+/*
+    hot reload: recompile changed FUNCTIONs into a running program
+    Copyright (C) 2012  microcai <microcai@fedoraproject.org>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+#pragma once
+
+#include <condition_variable>
+#include <ctime>
+#include <thread>
+#include <sys/types.h>
+#include <vector>
+
+#include "lazyjit.hpp"
+
+namespace qbc{
+
+// 源文件的修改时间 (纳秒) 和大小. st_mtime 只到秒, 一秒内存两次会漏掉第二次.
+struct FileStamp
+{
+	std::time_t	sec;
+	long		nsec;
+	off_t		size;
+
+	bool operator==(const FileStamp & other) const
+	{
+		return sec == other.sec && nsec == other.nsec && size == other.size;
+	}
+};
+
+// 在 LazyJIT 的基础上, 后台线程盯着源文件, 文件改了就重新解析整个文件,
+// 只把函数体变了的 FUNCTION/SUB 重新编译成 foo.vN, 然后原子地改写 foo.lazyptr.
+// 正在执行的旧代码跑完当前这次调用, 下一次调用就进新代码; 堆上的数组不受影响.
+// main 一直在栈上跑, 不能替换; 新增函数或者改了参数的函数要重启才生效.
+class ReloadJIT : public LazyJIT
+{
+	llvm::LLVMContext &						context;
+	std::string								path;
+	std::map<std::string, std::string>		fingerprints; // 函数名 -> 函数的源码
+	std::map<std::string, llvm::FunctionType*>	signatures;
+	unsigned								interval; // 检查文件的间隔, 毫秒
+	unsigned								generation;
+	FileStamp								stamp;
+	bool									stopping;
+	std::mutex								watchlock;
+	std::condition_variable					watchcond;
+	std::thread								watcher;
+
+	ReloadJIT(llvm::LLVMContext & context, const std::string & path, unsigned optlevel, unsigned interval);
+
+	// 和指纹比较 sources (functionsources 的结果), 返回 module 里源码有变化的函数.
+	// 指纹不在这里更新, patch 成功了才更新, 失败的下次保存还会再试.
+	std::vector<llvm::Function*> changed(llvm::Module * module, const std::map<std::string, std::string> & sources);
+	bool patch(llvm::Function * func);
+	void reload();
+	void watchloop();
+public:
+	virtual ~ReloadJIT();
+
+	// 接管 module (必须先经过 wrapmain), path 是它的源文件.
+	static ReloadJIT * create(llvm::Module * module, const std::string & path, unsigned optlevel,
+							  unsigned interval, std::string & err);
+};
+
+}
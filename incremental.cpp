@@ -0,0 +1,126 @@
+/*
+    per-function incremental native code generation
+    Copyright (C) 2012  microcai <microcai@fedoraproject.org>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#include <memory>
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/IR/LegacyPassManager.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include "incremental.hpp"
+#include "lazyjit.hpp"
+#include "optimizer.hpp"
+
+//#define debug	std::printf
+#define debug(...)
+
+namespace qbc{
+
+// 私有的全局变量 (字符串常量) 的名字随别的函数增减而变, 去掉名字按出现顺序编号.
+static std::string fingerprint(llvm::Module * module, unsigned optlevel)
+{
+	for(llvm::GlobalVariable & var : module->globals())
+	{
+		if(var.hasLocalLinkage())
+			var.setName("");
+	}
+
+	std::string ir;
+	llvm::raw_string_ostream os(ir);
+	module->print(os, NULL);
+	return cachekey(os.str(), optlevel);
+}
+
+// 缓存没有就优化, 生成代码, 存进缓存. 接管 module.
+static bool emitcached(llvm::Module * module, llvm::TargetMachine * tm, unsigned optlevel,
+					   DiskObjectCache & cache, std::vector<std::string> & objects, std::string & err)
+{
+	std::unique_ptr<llvm::Module> owner(module);
+	std::string key = fingerprint(module, optlevel);
+
+	objects.push_back(cache.path(key));
+
+	if(cache.contains(key))
+		return true;
+
+	debug("compiling %s\n", module->getModuleIdentifier().c_str());
+
+	module->setDataLayout(tm->createDataLayout());
+	optimize(module, optlevel, tm);
+
+	llvm::SmallString<4096> object;
+	llvm::raw_svector_ostream out(object);
+	llvm::legacy::PassManager pm;
+
+	if(tm->addPassesToEmitFile(pm, out, llvm::TargetMachine::CGFT_ObjectFile)){
+		err = "target can't emit object file";
+		return false;
+	}
+	pm.run(*module);
+
+	// 缓存以 module 的 identifier 为键.
+	module->setModuleIdentifier(key);
+	cache.notifyObjectCompiled(module, llvm::MemoryBufferRef(object.str(), key));
+
+	if(!cache.contains(key)){
+		err = "failed to write " + cache.path(key);
+		return false;
+	}
+	return true;
+}
+
+bool emitincremental(llvm::Module * module, llvm::TargetMachine * tm, unsigned optlevel,
+					 DiskObjectCache & cache, std::vector<std::string> & objects, std::string & err)
+{
+	std::unique_ptr<llvm::Module> owner(module);
+
+	module->setTargetTriple(tm->getTargetTriple().str());
+
+	// 每个函数都在自己的目标文件里, internal 的也要能被别的目标文件引用.
+	for(llvm::Function & func : *module)
+		func.setLinkage(llvm::GlobalValue::ExternalLinkage);
+
+	for(llvm::Function & func : *module)
+	{
+		if(func.isDeclaration())
+			continue;
+
+		llvm::Module * part = extractfunction(&func, true);
+		part->getFunction(func.getName().str() + LazyJIT::bodysuffix)->setName(func.getName());
+
+		if(!emitcached(part, tm, optlevel, cache, objects, err))
+			return false;
+	}
+
+	// 剩下的全局变量. 函数体都去掉, 只用于函数体的字符串常量也一起删掉.
+	for(llvm::Function & func : *module)
+		func.deleteBody();
+
+	for(llvm::Module::global_iterator it = module->global_begin(); it != module->global_end(); )
+	{
+		llvm::GlobalVariable & var = *it++;
+		if(var.hasLocalLinkage() && var.use_empty())
+			var.eraseFromParent();
+	}
+
+	return emitcached(owner.release(), tm, optlevel, cache, objects, err);
+}
+
+}
@@ -0,0 +1,43 @@
+/*
+    per-function incremental native code generation
+    Copyright (C) 2012  microcai <microcai@fedoraproject.org>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <llvm/IR/Module.h>
+#include <llvm/Target/TargetMachine.h>
+
+#include "objcache.hpp"
+
+namespace qbc{
+
+// 按函数增量地生成目标文件.
+//
+// 每个函数单独抽到一个 module 里 (同 LazyJIT), 它未优化的 IR 就是指纹:
+// 函数体, 签名, 用到的全局变量和被调函数的声明都在里面. 指纹没变就直接用缓存里的 .o,
+// 所以只有改过的函数, 以及被调函数签名变了的函数才重新优化和生成代码.
+// 全局变量留在一个单独的数据 module 里, 同样按指纹缓存.
+//
+// 函数之间不再跨函数内联, 相当于 C 的分开编译.
+// module 须先经过 wrapmain. 接管 module, 缓存里的目标文件名放进 objects, 链接完不要删.
+bool emitincremental(llvm::Module * module, llvm::TargetMachine * tm, unsigned optlevel,
+					 DiskObjectCache & cache, std::vector<std::string> & objects, std::string & err);
+
+}
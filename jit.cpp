@@ -0,0 +1,133 @@
+/*
+    run the generated module in-process with MCJIT
+    Copyright (C) 2012  microcai <microcai@fedoraproject.org>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+#include <llvm/IR/Function.h>
+#include <llvm/ExecutionEngine/MCJIT.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include "jit.hpp"
+#include "optimizer.hpp"
+#include "brt.h"
+
+//#define debug	std::printf
+#define debug(...)
+
+namespace qbc{
+
+// getbuiltinprotype 里能生成的 C 库函数和运行时.
+// 运行时直接取地址, 作为库链接进别的程序时它们不一定在动态符号表里.
+static const struct {
+	const char *	name;
+	void *			addr;
+} builtinsymbols[] = {
+	{ "printf",	(void*) &::printf },
+	{ "malloc",	(void*) &::malloc },
+	{ "calloc",	(void*) &::calloc },
+	{ "free",	(void*) &::free },
+	{ "strdup",	(void*) &::strdup },
+	{ "strlen",	(void*) &::strlen },
+	{ "strcpy",	(void*) &::strcpy },
+	{ "strcat",	(void*) &::strcat },
+	{ "strcmp",	(void*) &::strcmp },
+	{ "brt_print",	(void*) &::brt_print },
+	{ "brt_steps",	(void*) &::brt_steps },
+	{ "brt_budget_exceeded",	(void*) &::brt_budget_exceeded },
+	{ "brt_str_concat",	(void*) &::brt_str_concat },
+	{ "brt_str_retain",	(void*) &::brt_str_retain },
+	{ "brt_str_release",	(void*) &::brt_str_release },
+	{ "brt_str_assign",	(void*) &::brt_str_assign },
+	{ "brt_str_append",	(void*) &::brt_str_append },
+	{ "brt_str_store",	(void*) &::brt_str_store },
+	{ "btr_qbarray_new",	(void*) &::btr_qbarray_new },
+	{ "btr_qbarray_at",	(void*) &::btr_qbarray_at },
+	{ "btr_qbarray_cell",	(void*) &::btr_qbarray_cell },
+	{ "btr_qbarray_get",	(void*) &::btr_qbarray_get },
+	{ "btr_qbarray_getcell",	(void*) &::btr_qbarray_getcell },
+	{ "btr_qbarray_dim",	(void*) &::btr_qbarray_dim },
+	{ "btr_qbarray_free",	(void*) &::btr_qbarray_free },
+	// 内联进来的运行时函数会调用这些
+	{ "brt_abort",	(void*) &::brt_abort },
+	{ "brt_str_reserve",	(void*) &::brt_str_reserve },
+	{ "brt_str_resize",	(void*) &::brt_str_resize },
+	{ "brt_str_free",	(void*) &::brt_str_free },
+	{ "brt_array_grow",	(void*) &::brt_array_grow },
+	{ "brt_array_free",	(void*) &::brt_array_free },
+};
+
+void RuntimeMemoryManager::addsymbol(const std::string & name, void * addr)
+{
+	symbols[name] = (uint64_t)(uintptr_t) addr;
+}
+
+uint64_t RuntimeMemoryManager::getSymbolAddress(const std::string &name)
+{
+	std::map<std::string, uint64_t>::iterator it = symbols.find(name);
+	if(it != symbols.end())
+		return it->second;
+
+	for(auto & sym : builtinsymbols)
+	{
+		if(name == sym.name)
+			return (uint64_t)(uintptr_t) sym.addr;
+	}
+	debug("resolving %s in process\n", name.c_str());
+	// btr_* 之类的运行时函数, 到进程的符号表里找.
+	return llvm::SectionMemoryManager::getSymbolAddress(name);
+}
+
+llvm::ExecutionEngine * createjit(llvm::Module * module, unsigned optlevel, std::string & err,
+								  RuntimeMemoryManager * mm)
+{
+	llvm::EngineBuilder builder{std::unique_ptr<llvm::Module>(module)};
+
+	builder.setErrorStr(&err);
+	builder.setEngineKind(llvm::EngineKind::JIT);
+	builder.setOptLevel(codegenoptlevel(optlevel));
+	builder.setMCJITMemoryManager(std::unique_ptr<llvm::RTDyldMemoryManager>(mm ? mm : new RuntimeMemoryManager));
+
+	return builder.create();
+}
+
+int runmain(llvm::ExecutionEngine * engine)
+{
+	// 生成机器码, 并完成重定位.
+	// main 已经被 wrapmain 包装成了 int main(), 从缓存加载的时候也就不需要它的 llvm::Function 了.
+	uint64_t mainaddr = engine->getFunctionAddress("main");
+
+	if(!mainaddr){
+		llvm::errs() << "no main() in program\n";
+		return 1;
+	}
+
+	engine->runStaticConstructorsDestructors(false);
+
+	int ret = ((int (*)()) mainaddr)();
+
+	engine->runStaticConstructorsDestructors(true);
+
+	std::fflush(stdout);
+	return ret;
+}
+
+}
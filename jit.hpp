@@ -0,0 +1,52 @@
+/*
+    run the generated module in-process with MCJIT
+    Copyright (C) 2012  microcai <microcai@fedoraproject.org>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+#pragma once
+
+#include <map>
+#include <string>
+
+#include <llvm/IR/Module.h>
+#include <llvm/ExecutionEngine/ExecutionEngine.h>
+#include <llvm/ExecutionEngine/SectionMemoryManager.h>
+
+namespace qbc{
+
+// 为 JIT 生成的代码解析外部符号.
+// printf/strdup 这些由 getbuiltinprotype 声明的函数直接用编译器自身链接的那一份,
+// 其余的 (btr_* 运行时) 到进程里找.
+class RuntimeMemoryManager : public llvm::SectionMemoryManager
+{
+	std::map<std::string, uint64_t>	symbols;
+public:
+	virtual uint64_t getSymbolAddress(const std::string &name);
+
+	// 给某个 JIT 实例额外提供的宿主函数, 比如惰性编译的回调.
+	void addsymbol(const std::string & name, void * addr);
+};
+
+// 把 module 交给 MCJIT, engine 接管 module 的所有权.
+// mm 为 NULL 则使用默认的 RuntimeMemoryManager, 否则 engine 接管 mm.
+// 失败返回 NULL, 错误信息放在 err.
+llvm::ExecutionEngine * createjit(llvm::Module * module, unsigned optlevel, std::string & err,
+								  RuntimeMemoryManager * mm = NULL);
+
+// 执行生成的 main (必须先经过 wrapmain), 返回值作为进程的退出码.
+int runmain(llvm::ExecutionEngine * engine);
+
+}
@@ -0,0 +1,254 @@
+/*
+    compile-on-demand JIT, one module per FUNCTION/SUB
+    Copyright (C) 2012  microcai <microcai@fedoraproject.org>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <set>
+#include <vector>
+
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Transforms/Utils/Cloning.h>
+
+#include "jit.hpp"
+#include "lazyjit.hpp"
+#include "optimizer.hpp"
+
+//#define debug	std::printf
+#define debug(...)
+
+namespace qbc{
+
+const char * LazyJIT::bodysuffix = ".body";
+
+// foo.resolve 调用的宿主函数.
+static void * lazycompile(void * jit, const char * name)
+{
+	return static_cast<LazyJIT*>(jit)->compile(name);
+}
+
+// 收集 v 引用的全局符号. 字符串常量是通过 GEP 常量表达式引用的, 要递归进去.
+static void collectglobals(llvm::Value * v, std::set<llvm::GlobalValue*> & globals)
+{
+	if(llvm::GlobalValue * gv = llvm::dyn_cast<llvm::GlobalValue>(v)){
+		globals.insert(gv);
+		return;
+	}
+	if(llvm::Constant * c = llvm::dyn_cast<llvm::Constant>(v)){
+		for(llvm::Value * op : c->operands())
+			collectglobals(op, globals);
+	}
+}
+
+llvm::Module * extractfunction(llvm::Function * func, bool directrecursion)
+{
+	llvm::Module * src = func->getParent();
+	llvm::Module * module = new llvm::Module(func->getName(), src->getContext());
+
+	module->setTargetTriple(src->getTargetTriple());
+
+	llvm::Function * body = llvm::Function::Create(func->getFunctionType(), llvm::Function::ExternalLinkage,
+												   func->getName() + LazyJIT::bodysuffix, module);
+
+	llvm::ValueToValueMapTy vmap;
+
+	// 递归调用自己就不绕桩了.
+	if(directrecursion)
+		vmap[func] = body;
+
+	llvm::Function::arg_iterator dest = body->arg_begin();
+	for(llvm::Argument & arg : func->args())
+	{
+		dest->setName(arg.getName());
+		vmap[&arg] = &*dest++;
+	}
+
+	std::set<llvm::GlobalValue*> globals;
+	for(llvm::BasicBlock & bb : *func)
+		for(llvm::Instruction & inst : bb)
+			for(llvm::Value * op : inst.operands())
+				collectglobals(op, globals);
+
+	for(llvm::GlobalValue * gv : globals)
+	{
+		if(gv == func && directrecursion)
+			continue;
+
+		if(llvm::Function * callee = llvm::dyn_cast<llvm::Function>(gv)){
+			vmap[callee] = llvm::Function::Create(callee->getFunctionType(), llvm::Function::ExternalLinkage,
+												  callee->getName(), module);
+		}else if(llvm::GlobalVariable * var = llvm::dyn_cast<llvm::GlobalVariable>(gv)){
+			bool local = var->hasLocalLinkage();
+
+			llvm::GlobalVariable * newvar = new llvm::GlobalVariable(*module,
+				var->getType()->getElementType(), var->isConstant(),
+				local ? var->getLinkage() : llvm::GlobalValue::ExternalLinkage,
+				local ? var->getInitializer() : NULL, var->getName());
+
+			newvar->copyAttributesFrom(var);
+			vmap[var] = newvar;
+		}
+	}
+
+	llvm::SmallVector<llvm::ReturnInst*, 8> returns;
+	llvm::CloneFunctionInto(body, func, vmap, true, returns);
+
+	return module;
+}
+
+LazyJIT::LazyJIT(unsigned _optlevel)
+	: optlevel(_optlevel)
+	, directrecursion(true)
+{
+}
+
+LazyJIT::~LazyJIT()
+{
+	for(auto & item : pending)
+		delete item.second;
+}
+
+bool LazyJIT::split(llvm::Module * module, std::string & err)
+{
+	llvm::LLVMContext & context = module->getContext();
+	llvm::IRBuilder<> builder(context);
+
+	llvm::Module * stubs = new llvm::Module(module->getModuleIdentifier() + ".stubs", context);
+	stubs->setTargetTriple(module->getTargetTriple());
+
+	llvm::Constant * compilefunc = stubs->getOrInsertFunction("__qbc_lazy_compile",
+		llvm::FunctionType::get(builder.getInt8PtrTy(), {builder.getInt8PtrTy(), builder.getInt8PtrTy()}, false));
+
+	// 把 this 直接编码进桩里, 这样同一个进程里可以有多个 LazyJIT.
+	llvm::Constant * self = llvm::ConstantExpr::getIntToPtr(
+		builder.getInt64((uint64_t)(uintptr_t) this), builder.getInt8PtrTy());
+
+	for(llvm::Function & func : *module)
+	{
+		if(func.isDeclaration())
+			continue;
+
+		std::string name = func.getName();
+		llvm::FunctionType * functype = func.getFunctionType();
+
+		pending[name] = extractfunction(&func, directrecursion);
+
+		llvm::Function * stub = llvm::Function::Create(functype, llvm::Function::ExternalLinkage, name, stubs);
+		llvm::Function * resolve = llvm::Function::Create(functype, llvm::Function::InternalLinkage, name + ".resolve", stubs);
+
+		llvm::GlobalVariable * lazyptr = new llvm::GlobalVariable(*stubs, functype->getPointerTo(), false,
+			llvm::GlobalValue::ExternalLinkage, resolve, name + ".lazyptr");
+
+		std::vector<llvm::Value*> args;
+
+		// stub: 跳到 lazyptr 指向的地方.
+		for(llvm::Argument & arg : stub->args())
+			args.push_back(&arg);
+
+		builder.SetInsertPoint(llvm::BasicBlock::Create(context, "entrypoint", stub));
+		llvm::CallInst * call = builder.CreateCall(builder.CreateLoad(lazyptr), args);
+		call->setTailCall();
+
+		if(functype->getReturnType()->isVoidTy())
+			builder.CreateRetVoid();
+		else
+			builder.CreateRet(call);
+
+		// resolve: 编译函数体, 回填 lazyptr, 再转调.
+		// 回填用 cmpxchg, lazyptr 还指向 resolve 才写. 热重载或者分层 JIT 在这期间已经写了新地址的话, 以它们的为准.
+		args.clear();
+		for(llvm::Argument & arg : resolve->args())
+			args.push_back(&arg);
+
+		builder.SetInsertPoint(llvm::BasicBlock::Create(context, "entrypoint", resolve));
+		llvm::Value * addr = builder.CreateCall(compilefunc, {self, builder.CreateGlobalStringPtr(name)});
+		llvm::Value * target = builder.CreateBitCast(addr, functype->getPointerTo());
+		builder.CreateAtomicCmpXchg(lazyptr, resolve, target,
+			llvm::AtomicOrdering::AcquireRelease, llvm::AtomicOrdering::Monotonic);
+		call = builder.CreateCall(target, args);
+
+		if(functype->getReturnType()->isVoidTy())
+			builder.CreateRetVoid();
+		else
+			builder.CreateRet(call);
+	}
+
+	delete module;
+
+	RuntimeMemoryManager * mm = new RuntimeMemoryManager;
+	addsymbols(mm);
+
+	engine.reset(createjit(stubs, optlevel, err, mm));
+	return !!engine;
+}
+
+void LazyJIT::addsymbols(RuntimeMemoryManager * mm)
+{
+	mm->addsymbol("__qbc_lazy_compile", (void*) &lazycompile);
+}
+
+LazyJIT * LazyJIT::create(llvm::Module * module, unsigned optlevel, std::string & err)
+{
+	std::unique_ptr<LazyJIT> jit(new LazyJIT(optlevel));
+
+	if(!jit->split(module, err))
+		return NULL;
+	return jit.release();
+}
+
+void * LazyJIT::compilemodule(const std::string & name, llvm::Module * module)
+{
+	module->setDataLayout(engine->getDataLayout());
+	optimize(module, optlevel, engine->getTargetMachine());
+
+	engine->addModule(std::unique_ptr<llvm::Module>(module));
+	return (void*) engine->getFunctionAddress(name + bodysuffix);
+}
+
+void * LazyJIT::compile(const std::string & name)
+{
+	std::lock_guard<std::recursive_mutex> guard(lock);
+
+	debug("compiling %s on first call\n", name.c_str());
+
+	std::map<std::string, llvm::Module*>::iterator it = pending.find(name);
+
+	// 已经编译过了, 比如两个线程同时第一次调用.
+	if(it == pending.end())
+		return (void*) engine->getFunctionAddress(name + bodysuffix);
+
+	llvm::Module * module = it->second;
+	pending.erase(it);
+
+	void * addr = compilemodule(name, module);
+
+	if(!addr){
+		llvm::errs() << "failed to compile " << name << "\n";
+		std::abort();
+	}
+	return addr;
+}
+
+int LazyJIT::run()
+{
+	return runmain(engine.get());
+}
+
+}
@@ -0,0 +1,80 @@
+/*
+    compile-on-demand JIT, one module per FUNCTION/SUB
+    Copyright (C) 2012  microcai <microcai@fedoraproject.org>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <llvm/IR/Module.h>
+#include <llvm/ExecutionEngine/ExecutionEngine.h>
+
+namespace qbc{
+
+class RuntimeMemoryManager;
+
+// 把 func 复制到一个新的 module 里, 改名为 func.body.
+// 对其他函数的引用变成同名的声明, 链接时解析到桩上.
+// 私有的全局变量 (字符串常量) 复制一份过去.
+llvm::Module * extractfunction(llvm::Function * func, bool directrecursion);
+
+// 把生成的 module 按函数拆开, 每个函数一个 module, 第一次被调用的时候才编译.
+//
+// 对每个函数 foo 生成:
+//   foo.body    真正的函数体, 在它自己的 module 里, 尚未交给 MCJIT.
+//   foo         桩, 从 foo.lazyptr 取地址再跳过去, 所有对 foo 的调用都经过它.
+//   foo.lazyptr 初值是 foo.resolve.
+//   foo.resolve 编译 foo.body, lazyptr 还指向自己的话把地址写回去 (cmpxchg), 再转调.
+// 桩都放在一个 module 里, 启动时只编译这个 module.
+class LazyJIT
+{
+protected:
+	std::unique_ptr<llvm::ExecutionEngine>	engine;
+	std::map<std::string, llvm::Module*>	pending; // 还没编译的函数体
+	unsigned								optlevel;
+	std::recursive_mutex					lock;
+	bool									directrecursion; // 递归调用是否绕过桩
+
+	LazyJIT(unsigned optlevel);
+
+	// 优化, 交给 MCJIT 并取 name.body 的地址.
+	virtual void * compilemodule(const std::string & name, llvm::Module * module);
+
+	// 提供给生成代码的宿主函数.
+	virtual void addsymbols(RuntimeMemoryManager * mm);
+
+	bool split(llvm::Module * module, std::string & err);
+public:
+	virtual ~LazyJIT();
+
+	// 接管 module. 失败返回 NULL, 错误信息放在 err.
+	static LazyJIT * create(llvm::Module * module, unsigned optlevel, std::string & err);
+
+	// 供 foo.resolve 调用, 返回 foo.body 的地址.
+	void * compile(const std::string & name);
+
+	// 执行 main (必须先经过 wrapmain).
+	int run();
+
+	// 拆分后的函数体, 模块内全局符号名为 name + ".body"
+	static const char * bodysuffix;
+};
+
+}
@@ -19,6 +19,7 @@
 
 #include <llvm/IR/IRBuilder.h>
 #include "qbc.h"
+#include "brt.h"
 #include "ast.hpp"
 #include "llvmwrapper.hpp"
 
@@ -35,45 +36,87 @@ static unsigned sizeoflong()
 	return sizeof(long)*8;
 }
 
-llvm::Value * getnull()
+llvm::Value * getnull(ASTContext ctx)
 {
-	return llvm::ConstantPointerNull::get(llvm::Type::getInt8PtrTy(llvm::getGlobalContext()));
+	return llvm::ConstantPointerNull::get(llvm::Type::getInt8PtrTy(ctx.module->getContext()));
 }
 
-llvm::Value * getconstfalse()
+llvm::Value * getconstfalse(ASTContext ctx)
 {
-	return llvm::ConstantInt::get(llvm::getGlobalContext(),llvm::APInt(1,0,true));
+	return llvm::ConstantInt::get(ctx.module->getContext(),llvm::APInt(1,0,true));
 }
 
-llvm::Value * getconsttrue()
+llvm::Value * getconsttrue(ASTContext ctx)
 {
-	return llvm::ConstantInt::get(llvm::getGlobalContext(),llvm::APInt(1,1,true));
+	return llvm::ConstantInt::get(ctx.module->getContext(),llvm::APInt(1,1,true));
 }
 
-llvm::Value * getconstint(int v)
+llvm::Value * getconstint(ASTContext ctx, int v)
 {
-	return llvm::ConstantInt::get(llvm::getGlobalContext(),llvm::APInt(sizeofint(),(uint64_t)v,true));
+	return llvm::ConstantInt::get(ctx.module->getContext(),llvm::APInt(sizeofint(),(uint64_t)v,true));
 }
 
-llvm::Value * getconstlong(long v)
+llvm::Value * getconstlong(ASTContext ctx, long v)
 {
-	return llvm::ConstantInt::get(llvm::getGlobalContext(),llvm::APInt(sizeoflong(),(uint64_t)v,true));
+	return llvm::ConstantInt::get(ctx.module->getContext(),llvm::APInt(sizeoflong(),(uint64_t)v,true));
 }
 
-llvm::Type * getbooltype()
+llvm::Value * getconststring(ASTContext ctx, const std::string & str)
 {
-	return llvm::Type::getInt1Ty(llvm::getGlobalContext());
+	llvm::LLVMContext & context = ctx.module->getContext();
+	llvm::Type * longtype = getplatformlongtype(ctx);
+
+	llvm::Constant * chars = llvm::ConstantDataArray::getString(context, str);
+	llvm::StructType * type = llvm::StructType::get(context, {longtype, longtype, longtype, chars->getType()});
+
+	// refcount 为负, 运行时不会去释放它.
+	llvm::Constant * init = llvm::ConstantStruct::get(type, {
+		llvm::ConstantInt::get(longtype, -1, true),
+		llvm::ConstantInt::get(longtype, str.size()),
+		llvm::ConstantInt::get(longtype, str.size()),
+		chars});
+
+	llvm::GlobalVariable * global = new llvm::GlobalVariable(*ctx.module, type, true,
+		llvm::GlobalValue::PrivateLinkage, init, ".str");
+	global->setUnnamedAddr(true);
+
+	llvm::Constant * indices[] = {
+		llvm::ConstantInt::get(llvm::Type::getInt32Ty(context), 0),
+		llvm::ConstantInt::get(llvm::Type::getInt32Ty(context), 3),
+		llvm::ConstantInt::get(llvm::Type::getInt32Ty(context), 0)};
+
+	return llvm::ConstantExpr::getInBoundsGetElementPtr(type, global, indices);
+}
+
+// 同 QBArray, 按名字在 module 里找.
+llvm::Type * getstrvartype(ASTContext ctx)
+{
+	llvm::StructType * strvartype = ctx.module->getTypeByName("brt_strvar");
+	if(!strvartype){
+		llvm::LLVMContext & context = ctx.module->getContext();
+		llvm::Type * longtype = getplatformlongtype(ctx);
+
+		strvartype = llvm::StructType::create(context, {llvm::Type::getInt8PtrTy(context),
+			longtype, longtype, longtype, llvm::ArrayType::get(llvm::Type::getInt8Ty(context), BRT_STR_INLINE)},
+			"brt_strvar");
+	}
+	return strvartype;
 }
 
-llvm::Type * getplatformlongtype()
+llvm::Type * getbooltype(ASTContext ctx)
+{
+	return llvm::Type::getInt1Ty(ctx.module->getContext());
+}
+
+llvm::Type * getplatformlongtype(ASTContext ctx)
 {
 	switch(sizeof(long)){
 		case 8:
-			return llvm::Type::getInt64Ty(llvm::getGlobalContext());
+			return llvm::Type::getInt64Ty(ctx.module->getContext());
 		case 4:
-			return llvm::Type::getInt32Ty(llvm::getGlobalContext());
+			return llvm::Type::getInt32Ty(ctx.module->getContext());
 		case 2:
-			return llvm::Type::getInt16Ty(llvm::getGlobalContext());
+			return llvm::Type::getInt16Ty(ctx.module->getContext());
 	}
 }
 
@@ -105,7 +148,7 @@ static llvm::Constant *getbuiltinprotype_printf(ASTContext ctx)
 static llvm::Constant *getbuiltinprotype_brt_print(ASTContext ctx)
 {
 	GETBUILTINTYPE_ENTER();
-	args.push_back(getplatformlongtype());
+	args.push_back(getplatformlongtype(ctx));
 
 	llvm::Constant *brt_print =
 			ctx.module->getOrInsertFunction("brt_print",
@@ -116,11 +159,11 @@ static llvm::Constant *getbuiltinprotype_brt_print(ASTContext ctx)
 }
 
 BUILTINTYPE_DEFINE(malloc , Int8Ptr , {
-	args.push_back(getplatformlongtype());}  )
+	args.push_back(getplatformlongtype(ctx));}  )
 
 BUILTINTYPE_DEFINE(calloc , Int8Ptr , {
-	args.push_back(getplatformlongtype());
-	args.push_back(getplatformlongtype());}  )
+	args.push_back(getplatformlongtype(ctx));
+	args.push_back(getplatformlongtype(ctx));}  )
 
 BUILTINTYPE_DEFINE(free , Void , {args.push_back(builder.getInt8PtrTy());}  )
 
@@ -133,7 +176,7 @@ static llvm::Constant *getbuiltinprotype_strlen(ASTContext ctx)
 	args.push_back(builder.getInt8PtrTy());
 
 	llvm::Constant *func = ctx.module->getOrInsertFunction("strlen",
-										llvm::FunctionType::get(getplatformlongtype(), args,false));
+										llvm::FunctionType::get(getplatformlongtype(ctx), args,false));
 	return func;
 }
 
@@ -149,9 +192,33 @@ BUILTINTYPE_DEFINE(strcmp , Int32 , {
 	args.push_back(builder.getInt8PtrTy());
 	args.push_back(builder.getInt8PtrTy());}  )
 
+BUILTINTYPE_DEFINE(brt_str_concat , Int8Ptr , {
+	args.push_back(builder.getInt8PtrTy()->getPointerTo());
+	args.push_back(builder.getInt8PtrTy());
+	args.push_back(builder.getInt8PtrTy());}  )
+
+BUILTINTYPE_DEFINE(brt_str_retain , Int8Ptr , {
+	args.push_back(builder.getInt8PtrTy());}  )
+
+BUILTINTYPE_DEFINE(brt_str_release , Void , {
+	args.push_back(builder.getInt8PtrTy());}  )
+
+BUILTINTYPE_DEFINE(brt_str_assign , Void , {
+	args.push_back(builder.getInt8PtrTy()->getPointerTo());
+	args.push_back(builder.getInt8PtrTy());}  )
+
+BUILTINTYPE_DEFINE(brt_str_append , Void , {
+	args.push_back(builder.getInt8PtrTy()->getPointerTo());
+	args.push_back(builder.getInt8PtrTy());
+	args.push_back(builder.getInt8PtrTy());}  )
+
+BUILTINTYPE_DEFINE(brt_str_store , Void , {
+	args.push_back(builder.getInt8PtrTy()->getPointerTo());
+	args.push_back(builder.getInt8PtrTy());}  )
+
 BUILTINTYPE_DEFINE(btr_qbarray_new , Void , {
 	args.push_back(builder.getInt8PtrTy());
-	args.push_back(getplatformlongtype());}  )
+	args.push_back(getplatformlongtype(ctx));}  )
 
 
 BUILTINTYPE_DEFINE(btr_qbarray_free , Void , {
@@ -159,7 +226,26 @@ BUILTINTYPE_DEFINE(btr_qbarray_free , Void , {
 
 BUILTINTYPE_DEFINE(btr_qbarray_at , Int8Ptr , {
 	args.push_back(builder.getInt8PtrTy());
-	args.push_back(getplatformlongtype());}  )
+	args.push_back(getplatformlongtype(ctx));}  )
+
+BUILTINTYPE_DEFINE(btr_qbarray_cell , Int8Ptr , {
+	args.push_back(builder.getInt8PtrTy());
+	args.push_back(getplatformlongtype(ctx));
+	args.push_back(getplatformlongtype(ctx));}  )
+
+BUILTINTYPE_DEFINE(btr_qbarray_get , Int8Ptr , {
+	args.push_back(builder.getInt8PtrTy());
+	args.push_back(getplatformlongtype(ctx));}  )
+
+BUILTINTYPE_DEFINE(btr_qbarray_getcell , Int8Ptr , {
+	args.push_back(builder.getInt8PtrTy());
+	args.push_back(getplatformlongtype(ctx));
+	args.push_back(getplatformlongtype(ctx));}  )
+
+BUILTINTYPE_DEFINE(btr_qbarray_dim , Void , {
+	args.push_back(builder.getInt8PtrTy());
+	args.push_back(getplatformlongtype(ctx));
+	args.push_back(getplatformlongtype(ctx));}  )
 
 #undef BUILTINTYPE_DEFINE
 #undef GETBUILTINTYPE_ENTER
@@ -182,9 +268,19 @@ llvm::Constant * getbuiltinprotype(ASTContext ctx, const std::string name)
 		RETURNBUILTINENTRY(strcpy)
 		RETURNBUILTINENTRY(strcat)
 		RETURNBUILTINENTRY(strcmp)
+		RETURNBUILTINENTRY(brt_str_concat)
+		RETURNBUILTINENTRY(brt_str_retain)
+		RETURNBUILTINENTRY(brt_str_release)
+		RETURNBUILTINENTRY(brt_str_assign)
+		RETURNBUILTINENTRY(brt_str_append)
+		RETURNBUILTINENTRY(brt_str_store)
 		RETURNBUILTINENTRY(btr_qbarray_new)
 		RETURNBUILTINENTRY(btr_qbarray_free)
 		RETURNBUILTINENTRY(btr_qbarray_at)
+		RETURNBUILTINENTRY(btr_qbarray_cell)
+		RETURNBUILTINENTRY(btr_qbarray_get)
+		RETURNBUILTINENTRY(btr_qbarray_getcell)
+		RETURNBUILTINENTRY(btr_qbarray_dim)
 
 		printf("no define for %s yet\n",name.c_str());
 		exit(1);
@@ -21,17 +21,24 @@
 
 namespace qbc{
 
-llvm::Value * getnull();
-	
-llvm::Value * getconstint(int v);
+// 常量和类型都建在 ctx.module 所在的 LLVMContext 里.
+llvm::Value * getnull(ASTContext ctx);
 
-llvm::Value * getconstfalse();
-llvm::Value * getconsttrue();
+llvm::Value * getconstint(ASTContext ctx, int v);
 
-llvm::Value * getconstlong(long v);
+llvm::Value * getconstfalse(ASTContext ctx);
+llvm::Value * getconsttrue(ASTContext ctx);
+
+llvm::Value * getconstlong(ASTContext ctx, long v);
+
+// 字符串常量, 前面带着 brt_string 头 (见 brt.h), 返回指向字符的指针.
+llvm::Value * getconststring(ASTContext ctx, const std::string & str);
 
 llvm::Constant * getbuiltinprotype(ASTContext ctx, const std::string name);
 
-llvm::Type * getbooltype();
-llvm::Type * getplatformlongtype();
+// 字符串变量的存储, 即 brt.h 里的 struct brt_strvar.
+llvm::Type * getstrvartype(ASTContext ctx);
+
+llvm::Type * getbooltype(ASTContext ctx);
+llvm::Type * getplatformlongtype(ASTContext ctx);
 }
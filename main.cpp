@@ -23,8 +23,17 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <string>
 #include <iostream>
+#include <chrono>
+#include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
 
 #include "llvm/IR/Verifier.h"
 #include "llvm/ExecutionEngine/GenericValue.h"
@@ -34,15 +43,26 @@
 #include "llvm/IR/Instructions.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/ExecutionEngine/MCJIT.h"
 
 #include "ast.hpp"
-#include "parser.hpp"
-
-extern FILE *yyin;
-StatementAST * program;
+#include "frontend.hpp"
+#include "jit.hpp"
+#include "optimizer.hpp"
+#include "emitter.hpp"
+#include "objcache.hpp"
+#include "lazyjit.hpp"
+#include "tieredjit.hpp"
+#include "hotreload.hpp"
+#include "server.hpp"
+#include "repl.hpp"
+#include "project.hpp"
+#include "budget.hpp"
+#include "incremental.hpp"
+#include "runtime.hpp"
 
 // using namespace llvm;
 
@@ -161,48 +181,600 @@ StatementAST * program;
 //   return 0;
 // }
 
-int main(int argc, char **argv)
+// --time: 打印各阶段耗时到 stderr.
+class PhaseTimer
+{
+    bool enabled;
+    std::chrono::steady_clock::time_point start;
+public:
+    PhaseTimer(bool _enabled) : enabled(_enabled), start(std::chrono::steady_clock::now()) {}
+
+    void done(const char * phase)
+    {
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	if (enabled)
+	    llvm::errs() << "time: " << phase << " "
+		<< std::chrono::duration_cast<std::chrono::microseconds>(now - start).count() << " us\n";
+	start = now;
+    }
+};
+
+// -c : 只生成 .o
+// -o : 生成 .o 再和运行时一起链接成可执行文件
+// -j : 后端代码生成分成 jobs 个线程
+static int emitnative(llvm::Module * Module, const std::string & input, std::string output,
+		      bool compileonly, unsigned optlevel, unsigned jobs, PhaseTimer & timer)
+{
+    std::string err;
+    // --server 模式下 TargetMachine 是预先建好的.
+    llvm::TargetMachine * tm = qbc::cachedtargetmachine(optlevel, err);
+
+    if (!tm)
+    {
+	llvm::errs() << "failed to create target machine: " << err << "\n";
+	return 1;
+    }
+
+    std::string stem = input.substr(0, input.rfind('.'));
+    std::string object;
+
+    if (compileonly)
+	object = output.empty() ? stem + ".o" : output;
+    else
+	object = output + ".o";
+
+    Module->setDataLayout(tm->createDataLayout());
+    qbc::optimize(Module, optlevel, tm);
+    timer.done("optimize");
+
+    qbc::wrapmain(Module);
+
+    std::vector<std::string> objects;
+
+    if (jobs > 1)
+    {
+	// 按函数拆开, 多线程生成代码.
+	bool emitted = qbc::emitobjects(Module, optlevel, jobs, object, objects, err);
+	timer.done("emit");
+
+	if (emitted && compileonly)
+	{
+	    emitted = qbc::linkrelocatable(objects, object, err);
+	    timer.done("link");
+	}
+
+	if (!emitted || compileonly)
+	{
+	    for (const std::string & obj : objects)
+		std::remove(obj.c_str());
+	}
+
+	if (!emitted)
+	{
+	    llvm::errs() << err << "\n";
+	    return 1;
+	}
+
+	if (compileonly)
+	    return 0;
+    }
+    else
+    {
+	if (!qbc::emitobject(Module, tm, object, err))
+	{
+	    llvm::errs() << object << ": " << err << "\n";
+	    return 1;
+	}
+	timer.done("emit");
+
+	if (compileonly)
+	    return 0;
+
+	objects.push_back(object);
+    }
+
+    bool linked = qbc::linkexecutable(objects, output, err);
+
+    for (const std::string & obj : objects)
+	std::remove(obj.c_str());
+
+    if (!linked)
+    {
+	llvm::errs() << err << "\n";
+	return 1;
+    }
+    timer.done("link");
+    return 0;
+}
+
+// --incremental -o : 每个函数的目标文件按指纹缓存, 只重新编译改过的函数
+static int linkincremental(llvm::Module * Module, const std::string & output, unsigned optlevel, PhaseTimer & timer)
+{
+    std::string err;
+    llvm::TargetMachine * tm = qbc::cachedtargetmachine(optlevel, err);
+
+    if (!tm)
+    {
+	llvm::errs() << "failed to create target machine: " << err << "\n";
+	return 1;
+    }
+
+    qbc::wrapmain(Module);
+
+    qbc::DiskObjectCache cache;
+    std::vector<std::string> objects;
+
+    if (!cache.usable())
+	return 1;
+
+    if (!qbc::emitincremental(Module, tm, optlevel, cache, objects, err))
+    {
+	llvm::errs() << err << "\n";
+	return 1;
+    }
+    timer.done("emit");
+
+    // 目标文件在缓存里, 不删.
+    if (!qbc::linkexecutable(objects, output, err))
+    {
+	llvm::errs() << err << "\n";
+	return 1;
+    }
+    timer.done("link");
+    return 0;
+}
+
+// 缓存命中: 给 MCJIT 一个以缓存键命名的空 module, 它会从缓存里取目标文件.
+static int runcached(qbc::DiskObjectCache * cache, const std::string & key, unsigned optlevel, PhaseTimer & timer)
+{
+    std::string err;
+    llvm::LLVMContext context;
+    std::unique_ptr<llvm::ExecutionEngine> engine(
+	qbc::createjit(new llvm::Module(key, context), optlevel, err));
+
+    if (!engine)
+    {
+	llvm::errs() << "failed to construct ExecutionEngine: " << err << "\n";
+	return 1;
+    }
+
+    engine->setObjectCache(cache);
+    engine->finalizeObject();
+    timer.done("load cached object");
+
+    int ret = qbc::runmain(engine.get());
+    timer.done("run");
+    return ret;
+}
+
+// 文件以 #! 开头, 是被内核当成解释器调用的.
+static bool isscript(const char * path)
+{
+    char magic[2];
+    FILE * file = std::fopen(path, "r");
+
+    if (!file)
+	return false;
+
+    bool script = std::fread(magic, 1, 2, file) == 2 && magic[0] == '#' && magic[1] == '!';
+    std::fclose(file);
+    return script;
+}
+
+// #!/usr/bin/qbc 脚本: 第一次运行时按 -O2 编译成可执行文件放进缓存, 之后直接 exec 缓存里的,
+// 命中的时候连 LLVM 都不用初始化.
+static int runscript(const char * script, char ** argv)
 {
-    if (argc < 2)
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> source = llvm::MemoryBuffer::getFile(script);
+
+    if (!source)
     {
-	std::cout << "usage: prog [filename]" << std::endl;
+	std:: cout << "open " << script << " failed!" << std::endl;
+	return 1;
+    }
+
+    const unsigned optlevel = 2;
+
+    qbc::DiskObjectCache cache;
+    std::string image = cache.imagepath(qbc::cachekey((*source)->getBuffer(), optlevel));
+
+    // 别人能写的目录里的文件不能 exec.
+    if (!cache.usable())
 	return 1;
+
+    if (!llvm::sys::fs::exists(image))
+    {
+	llvm::InitializeNativeTarget();
+	llvm::InitializeNativeTargetAsmPrinter();
+	llvm::InitializeNativeTargetAsmParser();
+
+	std::string err;
+	llvm::LLVMContext context;
+	llvm::Module * module = qbc::compilesource((*source)->getBuffer().str(), context, script, err);
+
+	if (!module)
+	{
+	    llvm::errs() << script << ": " << err << "\n";
+	    return 1;
+	}
+
+	// 先链接到临时文件再改名, 同时启动的几个实例不会执行到写了一半的文件.
+	std::string tmp = image + "." + std::to_string(::getpid());
+	PhaseTimer timer(false);
+
+	if (emitnative(module, script, tmp, false, optlevel, 1, timer) != 0)
+	    return 1;
+
+	if (std::rename(tmp.c_str(), image.c_str()) != 0)
+	{
+	    std::perror(image.c_str());
+	    std::remove(tmp.c_str());
+	    return 1;
+	}
     }
-    
-    std::string input = argv[1];
 
-    std::cout << "openning: " << input << std::endl;
+    // argv[0] 是脚本自己.
+    ::execv(image.c_str(), argv);
+    std::perror(image.c_str());
+    return 1;
+}
 
-    yyin = std::fopen(input.c_str(), "r");
+// 命令行上的计数, 至少是 1, 不超过 max. 写错了不能悄悄变成 0 或者一个很大的数.
+static bool parsecount(const std::string & option, const char * value, uint64_t max, uint64_t & count)
+{
+    char * end;
 
-    if (!yyin)
+    errno = 0;
+    count = std::strtoull(value, &end, 10);
+    if (!std::isdigit((unsigned char) *value) || *end || errno == ERANGE || count < 1 || count > max)
+    {
+	llvm::errs() << option << " needs a number of at least 1, not '" << value << "'\n";
+	return false;
+    }
+    return true;
+}
+
+static void usage()
+{
+    std::cout << "usage: prog --server socket" << std::endl;
+    std::cout << "       prog script [args...]     (a #!/usr/bin/qbc script)" << std::endl;
+    std::cout << "       prog --repl [-O0|-O1|-O2|-O3]" << std::endl;
+    std::cout << "       prog --run [--max-steps N] [--max-heap bytes] [-O0|-O1|-O2|-O3] filename" << std::endl;
+    std::cout << "       prog --project -o output [-j jobs] [-O0|-O1|-O2|-O3] file.bas..." << std::endl;
+    std::cout << "       prog [--connect socket] [--run [--no-cache] [--lazy | --tiered [--tier-threshold N] | --hot-reload] | -c] [-o output [--incremental]] [-j jobs] [--time] [-O0|-O1|-O2|-O3] [filename]" << std::endl;
+}
+
+static int qbcmain(int argc, char **argv)
+{
+    bool run = false;
+    bool repl = false;
+    bool project = false;
+    bool usecache = true;
+    qbc::Budget budget;
+    bool lazy = false;
+    bool tiered = false;
+    bool hotreload = false;
+    bool incremental = false;
+    uint64_t tierthreshold = 10000;
+    bool compileonly = false;
+    bool timing = false;
+    std::string output;
+    unsigned optlevel = 0;
+    unsigned jobs = 1;
+    std::string input;
+    std::vector<std::string> inputs;
+
+    for (int i = 1; i < argc; i++)
+    {
+	std::string arg = argv[i];
+
+	if (arg == "--run")
+	    run = true;
+	else if (arg == "--repl")
+	    repl = true;
+	else if (arg == "--project")
+	    project = true;
+	else if (arg == "--lazy")
+	    lazy = true;
+	else if (arg == "--tiered")
+	    tiered = true;
+	else if (arg == "--hot-reload")
+	    hotreload = true;
+	else if (arg == "--incremental")
+	    incremental = true;
+	else if (arg == "--tier-threshold" && i + 1 < argc)
+	{
+	    // 0 永远到不了.
+	    if (!parsecount(arg, argv[++i], INT64_MAX, tierthreshold))
+		return 1;
+	}
+	else if (arg == "--no-cache")
+	    usecache = false;
+	// 给不受信任的代码用的, 写错了宁可不跑, 也不能变成 0 (不限).
+	else if (arg == "--max-steps" && i + 1 < argc)
+	{
+	    if (!parsecount(arg, argv[++i], UINT64_MAX, budget.steps))
+		return 1;
+	}
+	else if (arg == "--max-heap" && i + 1 < argc)
+	{
+	    if (!parsecount(arg, argv[++i], UINT64_MAX, budget.heap))
+		return 1;
+	}
+	else if (arg == "-c")
+	    compileonly = true;
+	else if (arg == "-o" && i + 1 < argc)
+	    output = argv[++i];
+	else if (arg == "-j" && i + 1 < argc)
+	    jobs = std::max(1, std::atoi(argv[++i]));
+	else if (arg == "--time")
+	    timing = true;
+	else if (arg.size() == 3 && arg[0] == '-' && arg[1] == 'O' && arg[2] >= '0' && arg[2] <= '3')
+	    optlevel = arg[2] - '0';
+	else if (arg[0] == '-')
+	{
+	    usage();
+	    return 1;
+	}
+	else
+	{
+	    if (!input.empty() && !project)
+	    {
+		usage();
+		return 1;
+	    }
+	    input = arg;
+	    inputs.push_back(arg);
+	}
+    }
+
+    // -O2 以上本该把运行时的小函数内联进来.
+    if ((optlevel > 1 || tiered) && !qbc::hasruntimebitcode())
+	llvm::errs() << "warning: runtime bitcode brt.bc not found, runtime calls will not be inlined\n";
+
+    // 多个文件, 各自编译, 一起链接.
+    if (project)
+    {
+	if (inputs.empty() || output.empty() || run || compileonly || repl)
+	{
+	    usage();
+	    return 1;
+	}
+
+	PhaseTimer timer(timing);
+	std::string err;
+
+	if (!qbc::buildproject(inputs, output, optlevel, jobs, err))
+	{
+	    llvm::errs() << err << "\n";
+	    return 1;
+	}
+	timer.done("build");
+	return 0;
+    }
+
+    // 交互模式, 从 stdin 读.
+    if (repl)
+    {
+	if (!input.empty() || run || compileonly || !output.empty())
+	{
+	    usage();
+	    return 1;
+	}
+
+	qbc::Repl session(optlevel);
+	return session.loop();
+    }
+
+    if (input.empty() || (run && (compileonly || !output.empty())) || ((lazy || tiered || hotreload) && !run) || (lazy + tiered + hotreload > 1)
+	|| ((budget.steps || budget.heap) && (!run || lazy || tiered || hotreload))
+	|| (incremental && (output.empty() || compileonly)))
+    {
+	usage();
+	return 1;
+    }
+
+    // -c 或者 -o 都是生成本地代码, 不再打印 IR.
+    bool native = compileonly || !output.empty();
+    bool quiet = run || native;
+
+    PhaseTimer timer(timing);
+
+    // 同样的源码, 同样的编译器, 同样的优化级别, 直接用上次的目标文件.
+    std::unique_ptr<qbc::DiskObjectCache> cache;
+    std::string cachekey;
+
+    // 惰性编译, 分层编译和热更新的时候每个函数单独编译, 不经过缓存.
+    // 插了预算检查的代码和普通的不一样, 也不经过缓存.
+    if (run && usecache && !lazy && !tiered && !hotreload && !budget.steps && !budget.heap)
+    {
+	llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> source = llvm::MemoryBuffer::getFile(input);
+
+	if (!source)
+	{
+	    std:: cout << "open " << input << " failed!" << std::endl;
+	    return 1;
+	}
+
+	cachekey = qbc::cachekey((*source)->getBuffer(), optlevel);
+	cache.reset(new qbc::DiskObjectCache);
+
+	// 用不了就不缓存, 照常编译.
+	if (!cache->usable())
+	    cache.reset();
+	else if (cache->contains(cachekey))
+	    return runcached(cache.get(), cachekey, optlevel, timer);
+    }
+
+    if (!quiet)
+	std::cout << "openning: " << input << std::endl;
+
+    FILE * file = std::fopen(input.c_str(), "r");
+
+    if (!file)
     {
 	std:: cout << "open " << input << " failed!" << std::endl;
 	return 1;
     }
 
-    qb::parser parser;
-    parser.parse();
+    std::string err;
+    StatementAST * program = qbc::parse(file, err);
+    std::fclose(file);
 
-    std::cout << "parse done, no errors!" << std::endl;
+    if (!program)
+    {
+	llvm::errs() << input << ": " << err << "\n";
+	return 1;
+    }
 
-    llvm::InitializeNativeTarget();
-    llvm::InitializeNativeTargetAsmPrinter();
-    llvm::InitializeNativeTargetAsmParser();
+    if (!quiet)
+	std::cout << "parse done, no errors!" << std::endl;
+    timer.done("parse");
 
     llvm::LLVMContext Context;
-    llvm::Module* Module = new llvm::Module("test", Context);
+    // the object cache is keyed by the module identifier
+    llvm::Module* Module = new llvm::Module(cache ? cachekey : input, Context);
 
-    ASTContext ctx;
-    ctx.module = Module;
+    if (!qbc::generate(program, Module, err))
+    {
+	llvm::errs() << input << ": " << err << "\n";
+	return 1;
+    }
 
-    CodeBlockAST gloablblock;
-    ctx.codeblock = &gloablblock;
+    if (llvm::verifyModule(*Module, &llvm::errs()))
+    {
+	llvm::errs() << input << ": invalid module generated\n";
+	if (!run)
+	    Module->dump();
+	return 1;
+    }
+    timer.done("codegen");
 
-    ((StatementAST*)(program))->Codegen(ctx);
+    if (incremental)
+	return linkincremental(Module, output, optlevel, timer);
 
-    std::cout << "Fib ir" << std::endl;
-    Module->dump();
+    if (native)
+	return emitnative(Module, input, output, compileonly, optlevel, jobs, timer);
 
-    return 0;
+    if (!run)
+    {
+	qbc::optimize(Module, optlevel);
+	timer.done("optimize");
+
+	std::cout << "Fib ir" << std::endl;
+	Module->dump();
+	return 0;
+    }
+
+    qbc::wrapmain(Module);
+
+    if (lazy)
+    {
+	std::unique_ptr<qbc::LazyJIT> jit(qbc::LazyJIT::create(Module, optlevel, err));
+
+	if (!jit)
+	{
+	    llvm::errs() << argv[0] << ": failed to construct ExecutionEngine: " << err << "\n";
+	    return 1;
+	}
+	timer.done("split");
+
+	int ret = jit->run();
+	timer.done("jit+run");
+	return ret;
+    }
+
+    if (tiered)
+    {
+	std::unique_ptr<qbc::TieredJIT> jit(qbc::TieredJIT::create(Module, tierthreshold, err));
+
+	if (!jit)
+	{
+	    llvm::errs() << argv[0] << ": failed to construct ExecutionEngine: " << err << "\n";
+	    return 1;
+	}
+	timer.done("split");
+
+	int ret = jit->run();
+	timer.done("jit+run");
+	return ret;
+    }
+
+    if (hotreload)
+    {
+	// 每 500ms 看一次源文件有没有改.
+	std::unique_ptr<qbc::ReloadJIT> jit(qbc::ReloadJIT::create(Module, input, optlevel, 500, err));
+
+	if (!jit)
+	{
+	    llvm::errs() << argv[0] << ": failed to construct ExecutionEngine: " << err << "\n";
+	    return 1;
+	}
+	timer.done("split");
+
+	int ret = jit->run();
+	timer.done("jit+run");
+	return ret;
+    }
+
+    bool budgeted = budget.steps || budget.heap;
+    qbc::RuntimeMemoryManager * mm = new qbc::RuntimeMemoryManager;
+
+    if (budgeted)
+    {
+	qbc::addbudgetchecks(Module);
+	qbc::addquotasymbols(mm);
+    }
+
+    std::unique_ptr<llvm::ExecutionEngine> engine(qbc::createjit(Module, optlevel, err, mm));
+
+    if (!engine)
+    {
+	llvm::errs() << argv[0] << ": failed to construct ExecutionEngine: " << err << "\n";
+	return 1;
+    }
+
+    if (cache)
+	engine->setObjectCache(cache.get());
+
+    // MCJIT 在第一次取函数地址时才生成机器码, 这里优化还来得及.
+    qbc::optimize(Module, optlevel, engine->getTargetMachine());
+    timer.done("optimize");
+
+    if (budgeted)
+    {
+	int ret = qbc::runbudgeted(engine.get(), budget, err);
+	timer.done("jit+run");
+
+	if (!err.empty())
+	{
+	    llvm::errs() << input << ": " << err << "\n";
+	    return 1;
+	}
+	return ret;
+    }
+
+    int ret = qbc::runmain(engine.get());
+    timer.done("jit+run");
+    return ret;
+}
+
+int main(int argc, char **argv)
+{
+    // 客户端不碰 LLVM, 把其余的参数原样交给 server.
+    if (argc >= 3 && std::string(argv[1]) == "--connect")
+	return qbc::connectserver(argv[2], argc - 3, argv + 3);
+
+    // 内核执行 #!/usr/bin/qbc 脚本时调用的是 qbc script args...
+    if (argc >= 2 && argv[1][0] != '-' && isscript(argv[1]))
+	return runscript(argv[1], argv + 1);
+
+    llvm::InitializeNativeTarget();
+    llvm::InitializeNativeTargetAsmPrinter();
+    llvm::InitializeNativeTargetAsmParser();
+
+    if (argc == 3 && std::string(argv[1]) == "--server")
+	return qbc::runserver(argv[2], qbcmain);
+
+    return qbcmain(argc, argv);
 }
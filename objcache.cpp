@@ -0,0 +1,157 @@
+/*
+    on-disk cache of the native objects compiled by the JIT
+    Copyright (C) 2012  microcai <microcai@fedoraproject.org>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include <cstdlib>
+
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Host.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include "qbc.h"
+#include "objcache.hpp"
+
+//#define debug	std::printf
+#define debug(...)
+
+// 正常由 cmake 按运行时和编译器的源码算出来, 没有的话至少每次编译都不一样.
+#ifndef QBC_BUILD_ID
+#define QBC_BUILD_ID __DATE__ " " __TIME__
+#endif
+
+namespace qbc{
+
+static std::string defaultcachedir()
+{
+	const char * xdg = std::getenv("XDG_CACHE_HOME");
+	if(xdg && *xdg)
+		return std::string(xdg) + "/qbasic";
+
+	const char * home = std::getenv("HOME");
+	if(home && *home)
+		return std::string(home) + "/.cache/qbasic";
+
+	// 没有 HOME 的时候 (cron, systemd), 每个用户一个目录.
+	return "/tmp/qbasic-cache-" + std::to_string(::geteuid());
+}
+
+// 缓存里的 .bin 会被直接 exec, .o 会被加载执行. 目录必须只有自己能写:
+// 是目录而不是符号链接, 属于自己, 组和其他人不可写.
+static bool privatedir(const std::string & dir)
+{
+	struct stat st;
+
+	if(::lstat(dir.c_str(), &st) < 0)
+		return false;
+	return S_ISDIR(st.st_mode) && st.st_uid == ::geteuid() && !(st.st_mode & (S_IWGRP | S_IWOTH));
+}
+
+DiskObjectCache::DiskObjectCache(const std::string & dir)
+	: cachedir(dir.empty() ? defaultcachedir() : dir)
+{
+	llvm::sys::fs::create_directories(llvm::sys::path::parent_path(cachedir));
+	::mkdir(cachedir.c_str(), 0700);
+
+	trusted = privatedir(cachedir);
+	if(!trusted)
+		llvm::errs() << "warning: cache directory " << cachedir << " is not private to this user, not using it\n";
+}
+
+std::string DiskObjectCache::path(const std::string & key)
+{
+	return cachedir + "/" + key + ".o";
+}
+
+std::string DiskObjectCache::imagepath(const std::string & key)
+{
+	return cachedir + "/" + key + ".bin";
+}
+
+bool DiskObjectCache::contains(const std::string & key)
+{
+	return trusted && llvm::sys::fs::exists(path(key));
+}
+
+void DiskObjectCache::notifyObjectCompiled(const llvm::Module *M, llvm::MemoryBufferRef Obj)
+{
+	if(!trusted)
+		return;
+
+	std::string target = path(M->getModuleIdentifier());
+
+	// 先写临时文件再改名, 同时跑的几个进程不会读到写了一半的缓存.
+	int fd;
+	llvm::SmallString<128> tmppath;
+
+	if(llvm::sys::fs::createUniqueFile(target + ".%%%%%%", fd, tmppath))
+		return;
+
+	{
+		llvm::raw_fd_ostream out(fd, true);
+		out << Obj.getBuffer();
+	}
+
+	if(llvm::sys::fs::rename(tmppath, target))
+		llvm::sys::fs::remove(tmppath);
+
+	debug("cached object %s\n", target.c_str());
+}
+
+std::unique_ptr<llvm::MemoryBuffer> DiskObjectCache::getObject(const llvm::Module* M)
+{
+	if(!trusted)
+		return nullptr;
+
+	llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer =
+		llvm::MemoryBuffer::getFile(path(M->getModuleIdentifier()));
+
+	if(!buffer)
+		return nullptr;
+
+	debug("cache hit for %s\n", M->getModuleIdentifier().c_str());
+	return std::move(*buffer);
+}
+
+std::string cachekey(llvm::StringRef source, unsigned optlevel)
+{
+	llvm::MD5 hash;
+
+	hash.update(VERSION);
+	hash.update(QBC_BUILD_ID);
+	hash.update(LLVM_VERSION_STRING);
+	hash.update(llvm::sys::getHostCPUName());
+	hash.update(llvm::StringRef(std::string("-O") + char('0' + optlevel)));
+	hash.update(source);
+
+	llvm::MD5::MD5Result result;
+	hash.final(result);
+
+	llvm::SmallString<32> key;
+	llvm::MD5::stringifyResult(result, key);
+	return key.str();
+}
+
+}
@@ -0,0 +1,58 @@
+/*
+    on-disk cache of the native objects compiled by the JIT
+    Copyright (C) 2012  microcai <microcai@fedoraproject.org>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <llvm/ADT/StringRef.h>
+#include <llvm/ExecutionEngine/ObjectCache.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+namespace qbc{
+
+// 缓存以 module 的 identifier 为键, 所以 module 的名字必须是 cachekey() 的结果.
+// 命中的时候, 只要给 MCJIT 一个同名的空 module, 它就会从这里取目标文件.
+class DiskObjectCache : public llvm::ObjectCache
+{
+	std::string	cachedir;
+	bool		trusted; // 目录只有自己能写, 否则什么都不读也不写
+public:
+	// dir 为空则用 $XDG_CACHE_HOME/qbasic 或者 ~/.cache/qbasic, 都没有就是 /tmp/qbasic-cache-<uid>.
+	// 目录不存在就按 0700 建; 不属于自己或者别人可写的话不用它, 见 usable().
+	DiskObjectCache(const std::string & dir = std::string());
+
+	bool usable() const { return trusted; }
+
+	virtual void notifyObjectCompiled(const llvm::Module *M, llvm::MemoryBufferRef Obj);
+	virtual std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module* M);
+
+	// 不用 module 直接查缓存.
+	bool contains(const std::string & key);
+
+	std::string path(const std::string & key);
+
+	// 同一个键的可执行文件, 给 #! 脚本用.
+	std::string imagepath(const std::string & key);
+};
+
+// 源码, 编译器的版本和 build id (运行时和编译器源码的 hash), LLVM 的版本, CPU 和优化级别都参与 hash.
+std::string cachekey(llvm::StringRef source, unsigned optlevel);
+
+}
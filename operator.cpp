@@ -79,46 +79,53 @@ PointerTypeASTPtr StringExprTypeAST::getpointetype()
 }
 
 
-ExprASTPtr ExprOperation::operator_assign(ASTContext, NamedExprASTPtr lval, ExprASTPtr rval)
+ExprASTPtr ExprOperation::operator_assign(ASTContext ctx, NamedExprASTPtr lval, ExprASTPtr rval)
 {
 	debug("can not assign to  this target\n");
-    exit(2);
+	ctx.error("can not assign to this target");
+	return errorplaceholder(ctx);
 }
 
-ExprASTPtr ExprOperation::operator_add(ASTContext, ExprASTPtr lval, ExprASTPtr rval)
+ExprASTPtr ExprOperation::operator_add(ASTContext ctx, ExprASTPtr lval, ExprASTPtr rval)
 {
 	debug("can not add this target\n");
-    exit(2);
+	ctx.error("can not add this target");
+	return errorplaceholder(ctx);
 }
 
-ExprASTPtr ExprOperation::operator_sub(ASTContext, ExprASTPtr lval, ExprASTPtr rval)
+ExprASTPtr ExprOperation::operator_sub(ASTContext ctx, ExprASTPtr lval, ExprASTPtr rval)
 {
 	debug("can not sub this target\n");
-    exit(2);
+	ctx.error("can not subtract this target");
+	return errorplaceholder(ctx);
 }
 
-ExprASTPtr ExprOperation::operator_mul(ASTContext, ExprASTPtr lval, ExprASTPtr rval)
+ExprASTPtr ExprOperation::operator_mul(ASTContext ctx, ExprASTPtr lval, ExprASTPtr rval)
 {
 	debug("can not mul this target\n");
-    exit(2);
+	ctx.error("can not multiply this target");
+	return errorplaceholder(ctx);
 }
 
-ExprASTPtr ExprOperation::operator_div(ASTContext, ExprASTPtr lval, ExprASTPtr rval)
+ExprASTPtr ExprOperation::operator_div(ASTContext ctx, ExprASTPtr lval, ExprASTPtr rval)
 {
 	debug("can not div this target\n");
-    exit(2);
+	ctx.error("can not divide this target");
+	return errorplaceholder(ctx);
 }
 
-ExprASTPtr ExprOperation::operator_comp(ASTContext, MathOperator op, ExprASTPtr lval, ExprASTPtr rval)
+ExprASTPtr ExprOperation::operator_comp(ASTContext ctx, MathOperator op, ExprASTPtr lval, ExprASTPtr rval)
 {
-    debug("can comp non-comp target\n");
-    exit(2);
+	debug("can comp non-comp target\n");
+	ctx.error("can not compare this target");
+	return errorplaceholder(ctx);
 }
 
-ExprASTPtr ExprOperation::operator_call(ASTContext, NamedExprASTPtr target, ExprListASTPtr callargslist)
+ExprASTPtr ExprOperation::operator_call(ASTContext ctx, NamedExprASTPtr target, ExprListASTPtr callargslist, bool store)
 {
 	debug("can not call on a non-callable target\n");
-	exit(2);
+	ctx.error("can not call or index this target");
+	return errorplaceholder(ctx);
 }
 
 //	call get on lval and rval, then wrapper an value to NumberExprAST;
@@ -130,24 +137,40 @@ ExprASTPtr NumberExprOperation::operator_assign(ASTContext ctx, NamedExprASTPtr
  	llvm::IRBuilder<> builder(ctx.block);
  	// 生成赋值语句,因为是简单的整型赋值,所以可以直接生成而不用调用 operator==()
 
-	LHS = builder.CreateBitCast(LHS,qbc::getplatformlongtype()->getPointerTo());
+	LHS = builder.CreateBitCast(LHS,qbc::getplatformlongtype(ctx)->getPointerTo());
   	builder.CreateStore(RHS,LHS);
 	return lval->type(ctx)->createtemp(ctx,LHS,NULL);
 }
 
-//TODO 添加 free + strdup  指令.
+// 字符串带引用计数, 赋值只是多一个引用, 旧的值少一个引用.
+// 变量里放得下的短字符串直接拷进去, 不用 malloc.
 ExprASTPtr StringExprOperation::operator_assign(ASTContext ctx, NamedExprASTPtr lval, ExprASTPtr rval)
 {
 	llvm::IRBuilder<> builder(ctx.block);
 
-	llvm::Constant * llvmfunc_free =  qbc::getbuiltinprotype(ctx,"free");
-	llvm::Constant * llvmfunc_strdup = qbc::getbuiltinprotype(ctx,"strdup");
+	// 数组元素的 type 是数组, 元素只有一个指针的空间.
+	bool variable = lval->type(ctx) == StringExprTypeAST::GetStringExprTypeAST();
 
-	builder.CreateCall(llvmfunc_free,lval->getval(ctx));
+	// s$ = s$ + x$, 直接追加到 s$ 后面, 循环里拼字符串才是线性的.
+	ExprASTPtr tail = variable ? rval->appendto(ctx, lval->variable(ctx)) : ExprASTPtr();
 
-	llvm::Value * dupedstr = builder.CreateCall(llvmfunc_strdup,rval->getval(ctx),"dumpstring");
+	if(tail){
+		llvm::Constant * llvmfunc_append = qbc::getbuiltinprotype(ctx,"brt_str_append");
 
-	builder.CreateStore(dupedstr,lval->getptr(ctx));
+		llvm::Value * str = lval->getval(ctx);
+		llvm::Value * tailstr = tail->getval(ctx);
+		llvm::Value * var = builder.CreateBitCast(lval->getptr(ctx), builder.getInt8PtrTy()->getPointerTo());
+
+		builder.CreateCall(llvmfunc_append, {var, str, tailstr});
+		return lval;
+	}
+
+	llvm::Constant * llvmfunc_assign = qbc::getbuiltinprotype(ctx, variable ? "brt_str_assign" : "brt_str_store");
+
+	// 数组元素的指针是 i8*, 统一转成 char**.
+	llvm::Value * var = builder.CreateBitCast(lval->getptr(ctx), builder.getInt8PtrTy()->getPointerTo());
+
+	builder.CreateCall(llvmfunc_assign, {var, rval->getval(ctx)});
 	return lval;
 }
 
@@ -179,25 +202,20 @@ ExprASTPtr NumberExprOperation::operator_add(ASTContext ctx, ExprASTPtr lval, Ex
 	return lval->type(ctx)->createtemp(ctx,result,NULL);
 }
 
-// 字符串加法.
+// 字符串加法. 长度在字符串头里, 不用 strlen, 分配一次再拷贝两段.
+// 结果短的话就放在入口处分配的临时变量里, 不用 malloc.
 ExprASTPtr StringExprOperation::operator_add(ASTContext ctx, ExprASTPtr lval, ExprASTPtr rval)
 {
 	llvm::IRBuilder<> builder(ctx.block);
+	llvm::IRBuilder<> entry(&ctx.llvmfunc->getEntryBlock(), ctx.llvmfunc->getEntryBlock().begin());
 
-	llvm::Constant * llvmfunc_calloc =  qbc::getbuiltinprotype(ctx,"malloc");
-	llvm::Constant * llvmfunc_strlen =  qbc::getbuiltinprotype(ctx,"strlen");
-	llvm::Constant * llvmfunc_strcpy = qbc::getbuiltinprotype(ctx,"strcpy");
-	llvm::Constant * llvmfunc_strcat = qbc::getbuiltinprotype(ctx,"strcat");
+	llvm::Value * tmp = entry.CreateAlloca(qbc::getstrvartype(ctx), 0, "concat");
 
-	llvm::Value * string_left_length = builder.CreateCall(llvmfunc_strlen,lval->getval(ctx));
-	llvm::Value * string_right_length = builder.CreateCall(llvmfunc_strlen,rval->getval(ctx));
+	llvm::Constant * llvmfunc_concat =  qbc::getbuiltinprotype(ctx,"brt_str_concat");
 
-	llvm::Value * result_length = builder.CreateAdd(string_left_length, string_right_length);
+	llvm::Value * resultstring = builder.CreateCall(llvmfunc_concat, {
+		builder.CreateBitCast(tmp, builder.getInt8PtrTy()->getPointerTo()), lval->getval(ctx), rval->getval(ctx)});
 
-	llvm::Value * resultstring = builder.CreateCall(llvmfunc_calloc,result_length);
-
-	builder.CreateCall(llvmfunc_strcpy, {resultstring, lval->getval(ctx)});
-	builder.CreateCall(llvmfunc_strcat, {resultstring, rval->getval(ctx)});
 	return 	lval->type(ctx)->createtemp(ctx, resultstring, NULL);
 }
 
@@ -290,13 +308,14 @@ ExprASTPtr StringExprOperation::operator_comp(ASTContext ctx,MathOperator op, Ex
 
 			result = builder.CreateCall(func_strcmp, {LHS, RHS});
 			// 返回值是 int , not long , 执行转化.
-			result = builder.CreateIntCast(result, qbc::getplatformlongtype(), true);
-			result = builder.CreateICmpEQ(result, qbc::getconstlong(0));
+			result = builder.CreateIntCast(result, qbc::getplatformlongtype(ctx), true);
+			result = builder.CreateICmpEQ(result, qbc::getconstlong(ctx, 0));
 		}
 		break;
 		default:
 			debug("string comp not supported");
-			exit(1);
+			ctx.error("strings can only be compared with =");
+			result = builder.getFalse();
 
 	}
 	//TODO , 构造临时 Number 对象.
@@ -304,24 +323,68 @@ ExprASTPtr StringExprOperation::operator_comp(ASTContext ctx,MathOperator op, Ex
 }
 
 // 那个, 数组下标调用.
-ExprASTPtr ArrayExprOperation::operator_call(ASTContext ctx, NamedExprASTPtr target, ExprListASTPtr callargslist)
+ExprASTPtr ArrayExprOperation::operator_call(ASTContext ctx, NamedExprASTPtr target, ExprListASTPtr callargslist, bool store)
 {
 	llvm::IRBuilder<>	builder(ctx.block);
 	debug("array index\n");
 
+	VariableDimAST * var = static_cast<VariableDimAST*>(target->nameresolve(ctx));
+	ArrayExprTypeAST * realtarget =static_cast<ArrayExprTypeAST*>(var->type.get());
+
+	debug("realtarget is %p\n",realtarget);
+
+	std::vector<ExprASTPtr> & subscripts = callargslist->expression_list;
+	size_t rank = realtarget->dims ? realtarget->dims->expression_list.size() : 1;
+
+	if(subscripts.size() != rank){
+		ctx.error("array " + var->name + " needs " + std::to_string(rank) + " subscripts, got "
+			+ std::to_string(subscripts.size()));
+		return errorplaceholder(ctx);
+	}
+
+	if(var->extents.size() != rank - 1){
+		ctx.error("array " + var->name + " is not dimensioned here");
+		return errorplaceholder(ctx);
+	}
+
 	// 获得数组地址.
-	llvm::Value * arrayptr = target->getptr(ctx);
-	// 获得下标.
-	llvm::Value * index = callargslist->expression_list.begin()->get()->getval(ctx);
+	llvm::Value * arrayptr = builder.CreateBitCast(target->getptr(ctx), builder.getInt8PtrTy());
+	// 获得下标, 第一个是行号.
+	llvm::Value * index = subscripts[0]->getval(ctx);
+	llvm::Value * tmpval;
+
+	if(rank == 1){
+		// 调用数组下标函数. 读的时候不扩容.
+		llvm::Constant * func_qb_array_at = qbc::getbuiltinprotype(ctx, store ? "btr_qbarray_at" : "btr_qbarray_get");
+
+		tmpval = builder.CreateCall(func_qb_array_at, {arrayptr, index});
+	}else{
+		// 其余的下标按行优先换算成一行里面的列号.
+		// 每个下标都要在自己那一维以内, 不然就落到别的行去了. 越界的话列号换成 -1, 由运行时报错.
+		llvm::Value * column = NULL;
+		llvm::Value * inrange = builder.getTrue();
+
+		for(size_t i = 1; i < rank; i++)
+		{
+			llvm::Value * extent = var->extents[i - 1];
 
-	// 调用数组下标函数.
-	llvm::Constant * func_qb_array_at = qbc::getbuiltinprotype(ctx,"btr_qbarray_at");
+			// REPL 里全局数组可能是在之前的 module 里定义的.
+			if(llvm::GlobalVariable * global = llvm::dyn_cast<llvm::GlobalVariable>(extent))
+				extent = ctx.module->getOrInsertGlobal(global->getName(), global->getType()->getElementType());
 
-	llvm::Value * tmpval = builder.CreateCall(func_qb_array_at, {arrayptr, index});
+			extent = builder.CreateLoad(extent);
+			llvm::Value * subscript = subscripts[i]->getval(ctx);
 
-	ArrayExprTypeAST * realtarget =static_cast<ArrayExprTypeAST*>(target->nameresolve(ctx)->type.get());
+			inrange = builder.CreateAnd(inrange, builder.CreateICmpULT(subscript, extent));
+			column = column ? builder.CreateAdd(builder.CreateMul(column, extent), subscript) : subscript;
+		}
 
-	debug("realtarget is %p\n",realtarget);
+		column = builder.CreateSelect(inrange, column, qbc::getconstlong(ctx, -1));
+
+		llvm::Constant * func_qb_array_cell = qbc::getbuiltinprotype(ctx, store ? "btr_qbarray_cell" : "btr_qbarray_getcell");
+
+		tmpval = builder.CreateCall(func_qb_array_cell, {arrayptr, index, column});
+	}
 
 	ExprASTPtr tmp = realtarget->elementtype->createtemp(ctx,NULL, tmpval);
 	debug("array index,  little tmp created as %p\n",tmp.get());
@@ -330,7 +393,7 @@ ExprASTPtr ArrayExprOperation::operator_call(ASTContext ctx, NamedExprASTPtr tar
 }
 
 // 函数调用.
-ExprASTPtr FunctionExprOperation::operator_call(ASTContext ctx,NamedExprASTPtr calltarget,ExprListASTPtr callargs)
+ExprASTPtr FunctionExprOperation::operator_call(ASTContext ctx,NamedExprASTPtr calltarget,ExprListASTPtr callargs, bool store)
 {
 	llvm::IRBuilder<> builder(ctx.llvmfunc->getContext());
 	builder.SetInsertPoint(ctx.block);
@@ -373,15 +436,19 @@ ExprASTPtr NumberExprTypeAST::createtemp(ASTContext ctx, llvm::Value* val , llvm
 	return std::make_shared<TempNumberExprAST>(ctx,val,ptr);
 }
 
+// 函数返回值和加法的结果带着一个引用, 等整条语句用完了再释放, 见 CodeBlockAST::Codegen.
 ExprASTPtr StringExprTypeAST::createtemp(ASTContext ctx, llvm::Value* val , llvm::Value *ptr)
 {
+    if(val && ctx.temps)
+	ctx.temps->push_back(val);
     return std::make_shared<TempStringExprAST>(ctx,val,ptr);
 }
 
 ExprASTPtr ArrayExprTypeAST::createtemp(ASTContext ctx, llvm::Value*v , llvm::Value *ptr)
 {
 	debug("allocate for ArrayExprTypeAST , elementtype is\n");//, elementtype->name(ctx).c_str());
-	exit(1);//	return this->elementtype->createtemp(ctx,v);
+	ctx.error("an array can not be used as a value");
+	return errorplaceholder(ctx);
 }
 
 //TODO
@@ -0,0 +1,225 @@
+/*
+    optimization pipeline run on the generated module
+    Copyright (C) 2012  microcai <microcai@fedoraproject.org>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include <set>
+#include <vector>
+
+#include <llvm/Analysis/CFG.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/LegacyPassManager.h>
+#include <llvm/IR/MDBuilder.h>
+#include <llvm/Analysis/TargetTransformInfo.h>
+#include <llvm/Transforms/IPO.h>
+#include <llvm/Transforms/IPO/PassManagerBuilder.h>
+#include <llvm/Transforms/Scalar.h>
+
+#include "optimizer.hpp"
+#include "runtime.hpp"
+
+namespace qbc{
+
+// 数组下标生成的是 btr_qbarray_at / btr_qbarray_cell 调用, 读的时候是 btr_qbarray_get /
+// btr_qbarray_getcell. 这里把它们展开: 下标在已分配的范围里就直接 ptr + row * stride + column * elementsize,
+// 只有要扩容, 读到范围外或者下标出错的时候才走冷路径调用运行时.
+// 这样优化器能看到对数组内存的访问. 在代码生成之后做, 表达式的代码生成里没法另开基本块.
+static void expandarrayaccess(llvm::Module * module, llvm::Function * at)
+{
+	std::vector<llvm::CallInst*> calls;
+	for(llvm::User * user : at->users())
+	{
+		llvm::CallInst * call = llvm::dyn_cast<llvm::CallInst>(user);
+		if(call && call->getCalledValue() == at)
+			calls.push_back(call);
+	}
+
+	llvm::LLVMContext & context = module->getContext();
+	llvm::IRBuilder<> builder(context);
+	llvm::MDNode * likely = llvm::MDBuilder(context).createBranchWeights(1 << 20, 1);
+
+	// 同 qbc.h 里的 QBArray.
+	llvm::Type * longtype = at->getFunctionType()->getParamType(1);
+	llvm::StructType * arraytype = llvm::StructType::get(context,
+		{builder.getInt8PtrTy(), longtype, longtype, longtype});
+
+	for(llvm::CallInst * call : calls)
+	{
+		llvm::BasicBlock * block = call->getParent();
+		llvm::Function * func = block->getParent();
+		llvm::BasicBlock * rest = block->splitBasicBlock(call, "array.cont");
+		llvm::BasicBlock * slow = llvm::BasicBlock::Create(context, "array.slow", func);
+
+		block->getTerminator()->eraseFromParent();
+		builder.SetInsertPoint(block);
+
+		llvm::Value * array = builder.CreateBitCast(call->getArgOperand(0), arraytype->getPointerTo());
+		llvm::Value * row = call->getArgOperand(1);
+
+		llvm::Value * data = builder.CreateLoad(builder.CreateStructGEP(arraytype, array, 0));
+		llvm::Value * stride = builder.CreateLoad(builder.CreateStructGEP(arraytype, array, 2));
+		llvm::Value * capacity = builder.CreateLoad(builder.CreateStructGEP(arraytype, array, 3));
+
+		// 无符号比较, 负的下标也落到慢路径, 由运行时报错.
+		// row < capacity 保证了 row * stride 不会溢出. 整行都在范围里才走快路径.
+		llvm::Value * offset = builder.CreateMul(row, stride);
+		llvm::Value * inbounds = builder.CreateAnd(builder.CreateICmpULT(row, capacity),
+			builder.CreateICmpULE(builder.CreateAdd(offset, stride), capacity));
+
+		// 列号要在一行以内.
+		if(call->getNumArgOperands() == 3){
+			llvm::Value * column = call->getArgOperand(2);
+			llvm::Value * elementsize = builder.CreateLoad(builder.CreateStructGEP(arraytype, array, 1));
+			llvm::Value * columnoffset = builder.CreateMul(column, elementsize);
+
+			inbounds = builder.CreateAnd(inbounds, builder.CreateAnd(builder.CreateICmpULT(column, stride),
+				builder.CreateICmpULE(builder.CreateAdd(columnoffset, elementsize), stride)));
+			offset = builder.CreateAdd(offset, columnoffset);
+		}
+
+		llvm::Value * fast = builder.CreateInBoundsGEP(data, offset);
+		builder.CreateCondBr(inbounds, rest, slow, likely);
+
+		// 原来的调用挪到慢路径里.
+		call->removeFromParent();
+		slow->getInstList().push_back(call);
+		builder.SetInsertPoint(slow);
+		builder.CreateBr(rest);
+
+		builder.SetInsertPoint(rest, rest->begin());
+		llvm::PHINode * element = builder.CreatePHI(call->getType(), 2);
+		call->replaceAllUsesWith(element);
+		element->addIncoming(fast, block);
+		element->addIncoming(call, slow);
+	}
+}
+
+void addcounterchecks(llvm::Function * func, llvm::GlobalVariable * counter, int64_t step,
+	llvm::CmpInst::Predicate pred, int64_t limit, llvm::Value * callee, llvm::ArrayRef<llvm::Value*> args,
+	const std::string & name)
+{
+	llvm::LLVMContext & context = func->getContext();
+	llvm::IRBuilder<> builder(context);
+	llvm::Type * countertype = counter->getType()->getElementType();
+
+	llvm::BasicBlock::iterator entry = func->getEntryBlock().getFirstInsertionPt();
+	while(llvm::isa<llvm::AllocaInst>(&*entry))
+		++entry;
+
+	std::vector<llvm::Instruction*> points;
+	points.push_back(&*entry);
+
+	llvm::SmallVector<std::pair<const llvm::BasicBlock*, const llvm::BasicBlock*>, 8> backedges;
+	llvm::FindFunctionBackedges(*func, backedges);
+
+	std::set<const llvm::BasicBlock*> sources;
+	for(auto & edge : backedges)
+	{
+		if(sources.insert(edge.first).second)
+			points.push_back(const_cast<llvm::BasicBlock*>(edge.first)->getTerminator());
+	}
+
+	for(llvm::Instruction * point : points)
+	{
+		llvm::BasicBlock * block = point->getParent();
+		llvm::BasicBlock * rest = block->splitBasicBlock(point, name + ".cont");
+		llvm::BasicBlock * hit = llvm::BasicBlock::Create(context, name + ".hit", func, rest);
+
+		// splitBasicBlock 留下的无条件跳转换成计数和判断.
+		block->getTerminator()->eraseFromParent();
+		builder.SetInsertPoint(block);
+
+		llvm::Value * count = builder.CreateAdd(builder.CreateLoad(counter), llvm::ConstantInt::get(countertype, step));
+		builder.CreateStore(count, counter);
+		builder.CreateCondBr(builder.CreateICmp(pred, count, llvm::ConstantInt::get(countertype, limit)), hit, rest);
+
+		builder.SetInsertPoint(hit);
+		builder.CreateCall(callee, args);
+		builder.CreateBr(rest);
+	}
+}
+
+llvm::CodeGenOpt::Level codegenoptlevel(unsigned optlevel)
+{
+	switch(optlevel){
+		case 0:
+			return llvm::CodeGenOpt::None;
+		case 1:
+			return llvm::CodeGenOpt::Less;
+		case 2:
+			return llvm::CodeGenOpt::Default;
+	}
+	return llvm::CodeGenOpt::Aggressive;
+}
+
+void optimize(llvm::Module * module, unsigned optlevel, llvm::TargetMachine * tm)
+{
+	// 每个变量都是 alloca 出来的, -O0 也不做 mem2reg, 保持可调试.
+	// 不过 main 和导出函数用不到的 internal 函数还是删掉, 省得生成代码.
+	if(optlevel == 0){
+		llvm::legacy::PassManager mpm;
+		mpm.add(llvm::createGlobalDCEPass());
+		mpm.run(*module);
+		return;
+	}
+
+	if(llvm::Function * at = module->getFunction("btr_qbarray_at"))
+		expandarrayaccess(module, at);
+	if(llvm::Function * cell = module->getFunction("btr_qbarray_cell"))
+		expandarrayaccess(module, cell);
+	if(llvm::Function * get = module->getFunction("btr_qbarray_get"))
+		expandarrayaccess(module, get);
+	if(llvm::Function * getcell = module->getFunction("btr_qbarray_getcell"))
+		expandarrayaccess(module, getcell);
+
+	llvm::PassManagerBuilder pmb;
+	pmb.OptLevel = optlevel;
+	pmb.SizeLevel = 0;
+
+	// -O1 只内联 alwaysinline 的, 同 clang.
+	if(optlevel > 1){
+		pmb.Inliner = llvm::createFunctionInliningPass(optlevel, 0);
+		// 运行时的小函数也能内联进来.
+		linkruntime(module);
+	}else
+		pmb.Inliner = llvm::createAlwaysInlinerPass();
+
+	pmb.LoopVectorize = optlevel > 1;
+	pmb.SLPVectorize = optlevel > 1;
+
+	llvm::legacy::FunctionPassManager fpm(module);
+	llvm::legacy::PassManager mpm;
+
+	if(tm){
+		fpm.add(llvm::createTargetTransformInfoWrapperPass(tm->getTargetIRAnalysis()));
+		mpm.add(llvm::createTargetTransformInfoWrapperPass(tm->getTargetIRAnalysis()));
+	}
+
+	// 函数级: mem2reg(SROA), instcombine, simplifycfg ...
+	pmb.populateFunctionPassManager(fpm);
+	// 模块级: 内联, GVN, 循环优化, 向量化 ...
+	pmb.populateModulePassManager(mpm);
+
+	fpm.doInitialization();
+	for(llvm::Function & func : *module)
+		fpm.run(func);
+	fpm.doFinalization();
+
+	mpm.run(*module);
+}
+
+}
@@ -0,0 +1,44 @@
+/*
+    optimization pipeline run on the generated module
+    Copyright (C) 2012  microcai <microcai@fedoraproject.org>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+#pragma once
+
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/IR/InstrTypes.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/CodeGen.h>
+#include <llvm/Target/TargetMachine.h>
+
+namespace qbc{
+
+// -O0 .. -O3 , 同 clang 的意义.
+// tm 可以为 NULL, 那样就没有目标相关的代价模型 (向量化会保守一些).
+void optimize(llvm::Module * module, unsigned optlevel, llvm::TargetMachine * tm = NULL);
+
+// 后端使用的优化级别.
+llvm::CodeGenOpt::Level codegenoptlevel(unsigned optlevel);
+
+// 在函数入口和每条循环回边上插入计数, 预算检查和分层 JIT 的热度计数都用它:
+//   counter += step; if(counter pred limit) callee(args...);
+// 入口的计数放在开头的 alloca 后面, alloca 留在入口块里 mem2reg/SROA 才认.
+// 新的基本块叫 name.cont 和 name.hit. 要在优化之前调用, 循环还没被改写.
+void addcounterchecks(llvm::Function * func, llvm::GlobalVariable * counter, int64_t step,
+	llvm::CmpInst::Predicate pred, int64_t limit, llvm::Value * callee, llvm::ArrayRef<llvm::Value*> args,
+	const std::string & name);
+
+}
@@ -0,0 +1,393 @@
+/*
+    multi-file project builds
+    Copyright (C) 2012  microcai <microcai@fedoraproject.org>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <thread>
+
+#include <llvm/IR/Verifier.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include "ast.hpp"
+#include "emitter.hpp"
+#include "frontend.hpp"
+#include "objcache.hpp"
+#include "optimizer.hpp"
+#include "project.hpp"
+
+//#define debug	std::printf
+#define debug(...)
+
+namespace qbc{
+
+// 工程里的一个源文件.
+struct Unit
+{
+	Unit() : failed(false) {}
+
+	std::string		source;
+	std::string		object;
+	std::string		depfile;
+	std::string		key;		// 源码的 hash
+	ParseState		state;
+	bool			failed;
+	std::string		err;
+	std::map<std::string, std::string>	imports; // 用到的别的文件里的函数 -> 签名
+};
+
+// 某个文件导出的函数.
+struct Export
+{
+	Export() : func(NULL), unit(NULL) {}
+
+	FunctionDimAST *	func;
+	Unit *				unit;
+	std::string			signature;
+};
+
+typedef std::map<std::string, Export> ExportTable;
+
+// 把 count 个任务分给 jobs 个线程, 谁空下来谁取下一个.
+static void parallel(size_t count, unsigned jobs, const std::function<void(size_t)> & task)
+{
+	std::atomic<size_t> next(0);
+	std::vector<std::thread> workers;
+
+	for(unsigned i = 0; i < jobs && i < count; i++)
+	{
+		workers.emplace_back([&]{
+			for(size_t n; (n = next++) < count; )
+				task(n);
+		});
+	}
+
+	for(std::thread & worker : workers)
+		worker.join();
+}
+
+static bool collecterrors(const std::vector<std::unique_ptr<Unit>> & units, std::string & err)
+{
+	for(const std::unique_ptr<Unit> & unit : units)
+	{
+		if(!unit->failed)
+			continue;
+		if(!err.empty())
+			err += "\n";
+		err += unit->err;
+	}
+	return err.empty();
+}
+
+static bool parseunit(Unit & unit, unsigned optlevel)
+{
+	llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> source = llvm::MemoryBuffer::getFile(unit.source);
+
+	if(!source){
+		unit.err = "open " + unit.source + " failed!";
+		return false;
+	}
+
+	unit.key = cachekey((*source)->getBuffer(), optlevel);
+
+	// 词法分析器只认 FILE*, 用 fmemopen 包一下.
+	FILE * file = fmemopen((void*) (*source)->getBufferStart(), (*source)->getBufferSize(), "r");
+
+	if(!file){
+		unit.err = unit.source + ": fmemopen failed";
+		return false;
+	}
+
+	bool parsed = parse(file, unit.state);
+	std::fclose(file);
+
+	if(!parsed){
+		unit.err = unit.source + ": " + unit.state.error;
+		return false;
+	}
+	return true;
+}
+
+// 给别的文件里定义的 func 做一个只用来声明的副本, 每个 module 一份.
+static FunctionDimAST * importof(FunctionDimAST * func)
+{
+	FunctionDimAST * import = new FunctionDimAST(func->name, func->type);
+	import->callargs = func->callargs;
+	return import;
+}
+
+static std::string typestring(llvm::Type * type)
+{
+	std::string text;
+	llvm::raw_string_ostream os(text);
+	type->print(os);
+	return os.str();
+}
+
+// .dep 文件: 第一行是源码的 hash, 之后每行是 "函数名 签名".
+static bool readdeps(const std::string & path, std::string & key, std::map<std::string, std::string> & imports)
+{
+	std::ifstream in(path);
+	std::string line;
+
+	if(!std::getline(in, key))
+		return false;
+
+	while(std::getline(in, line))
+	{
+		size_t space = line.find(' ');
+		if(space == std::string::npos)
+			return false;
+		imports[line.substr(0, space)] = line.substr(space + 1);
+	}
+	return true;
+}
+
+static bool writedeps(const Unit & unit)
+{
+	std::ofstream out(unit.depfile);
+
+	out << unit.key << "\n";
+	for(auto & item : unit.imports)
+		out << item.first << " " << item.second << "\n";
+
+	out.close();
+	return !out.fail();
+}
+
+// 目标文件还在, 源码没变, 用到的外部函数签名也没变.
+static bool uptodate(const Unit & unit, const ExportTable & exports)
+{
+	std::string key;
+	std::map<std::string, std::string> imports;
+
+	if(!llvm::sys::fs::exists(unit.object) || !readdeps(unit.depfile, key, imports) || key != unit.key)
+		return false;
+
+	for(auto & item : imports)
+	{
+		ExportTable::const_iterator it = exports.find(item.first);
+
+		if(it == exports.end() || it->second.signature != item.second)
+			return false;
+	}
+	return true;
+}
+
+// 在自己的 LLVMContext 和 TargetMachine 里编译, 可以在任意线程上跑.
+static bool compileunit(Unit & unit, const ExportTable & exports, unsigned optlevel)
+{
+	// 编译到一半失败的话, 不能留下看起来是最新的 .dep.
+	llvm::sys::fs::remove(unit.depfile);
+
+	llvm::LLVMContext context;
+	std::unique_ptr<llvm::Module> module(new llvm::Module(unit.source, context));
+
+	std::string errors;
+
+	ASTContext ctx;
+	ctx.module = module.get();
+	ctx.errors = &errors;
+
+	CodeBlockAST globalblock;
+	ctx.codeblock = &globalblock;
+
+	// 先把别的文件导出的函数都声明一下, 调用的时候才找得到.
+	std::vector<std::unique_ptr<FunctionDimAST>> imports;
+
+	for(auto & item : exports)
+	{
+		if(item.second.unit == &unit)
+			continue;
+
+		imports.emplace_back(importof(item.second.func));
+		imports.back()->declare(ctx);
+	}
+
+	// 只有函数定义的文件, 顶层是个 CodeBlockAST, 挂到 globalblock 下面.
+	if(!unit.state.useDefautSubMain)
+		static_cast<CodeBlockAST*>(unit.state.program)->parent = &globalblock;
+
+	unit.state.program->Codegen(ctx);
+
+	if(!errors.empty()){
+		unit.err = unit.source + ": " + errors;
+		return false;
+	}
+
+	llvm::raw_string_ostream os(unit.err);
+	if(llvm::verifyModule(*module, &os)){
+		os.flush();
+		unit.err = unit.source + ": invalid module generated\n" + unit.err;
+		return false;
+	}
+
+	// 记下真正用到的外部函数, 没用到的声明删掉.
+	std::vector<llvm::Function*> unused;
+	unit.imports.clear();
+
+	for(llvm::Function & func : *module)
+	{
+		if(!func.isDeclaration() || !exports.count(func.getName().str()))
+			continue;
+
+		if(func.use_empty())
+			unused.push_back(&func);
+		else
+			unit.imports[func.getName().str()] = typestring(func.getFunctionType());
+	}
+
+	for(llvm::Function * func : unused)
+		func->eraseFromParent();
+
+	wrapmain(module.get());
+
+	// TargetMachine 不能在线程之间共用.
+	std::string err;
+	std::unique_ptr<llvm::TargetMachine> tm(createtargetmachine(optlevel, err));
+
+	if(!tm){
+		unit.err = "failed to create target machine: " + err;
+		return false;
+	}
+
+	module->setDataLayout(tm->createDataLayout());
+	optimize(module.get(), optlevel, tm.get());
+
+	if(!emitobject(module.get(), tm.get(), unit.object, err)){
+		unit.err = unit.object + ": " + err;
+		return false;
+	}
+
+	if(!writedeps(unit)){
+		unit.err = unit.depfile + ": write failed";
+		return false;
+	}
+
+	debug("compiled %s\n", unit.source.c_str());
+	return true;
+}
+
+// output 比所有的目标文件都新.
+static bool linked(const std::string & output, const std::vector<std::string> & objects)
+{
+	llvm::sys::fs::file_status outstat, objstat;
+
+	if(llvm::sys::fs::status(output, outstat) || !llvm::sys::fs::exists(outstat))
+		return false;
+
+	for(const std::string & object : objects)
+	{
+		if(llvm::sys::fs::status(object, objstat)
+			|| objstat.getLastModificationTime() > outstat.getLastModificationTime())
+			return false;
+	}
+	return true;
+}
+
+bool buildproject(const std::vector<std::string> & sources, const std::string & output,
+				  unsigned optlevel, unsigned jobs, std::string & err)
+{
+	std::vector<std::unique_ptr<Unit>> units;
+
+	for(const std::string & source : sources)
+	{
+		units.emplace_back(new Unit);
+
+		Unit & unit = *units.back();
+		unit.source = source;
+		unit.object = source.substr(0, source.rfind('.')) + ".o";
+		unit.depfile = unit.object + ".dep";
+	}
+
+	parallel(units.size(), jobs, [&](size_t n){
+		units[n]->failed = !parseunit(*units[n], optlevel);
+	});
+
+	if(!collecterrors(units, err))
+		return false;
+
+	// 收集导出的函数, 同名的只能有一个. 签名在一个临时的 module 里生成.
+	ExportTable exports;
+
+	llvm::LLVMContext context;
+	llvm::Module scratch("qbc.project.signatures", context);
+
+	ASTContext ctx;
+	ctx.module = &scratch;
+
+	CodeBlockAST scratchblock;
+	ctx.codeblock = &scratchblock;
+
+	for(std::unique_ptr<Unit> & unit : units)
+	{
+		for(FunctionDimAST * func : unit->state.functions)
+		{
+			// main 由 wrapmain 处理, 也不给别人调. 没有 EXPORT 的是文件内部的.
+			if(func->name == "main" || func->linkage != EXTERN)
+				continue;
+
+			Export & entry = exports[func->name];
+
+			if(entry.func){
+				err = func->name + " is defined in both " + entry.unit->source + " and " + unit->source;
+				return false;
+			}
+
+			entry.func = func;
+			entry.unit = unit.get();
+
+			std::unique_ptr<FunctionDimAST> import(importof(func));
+			import->declare(ctx);
+			entry.signature = typestring(scratch.getFunction(func->name)->getFunctionType());
+		}
+	}
+
+	std::vector<Unit*> dirty;
+
+	for(std::unique_ptr<Unit> & unit : units)
+	{
+		if(!uptodate(*unit, exports))
+			dirty.push_back(unit.get());
+	}
+
+	parallel(dirty.size(), jobs, [&](size_t n){
+		dirty[n]->failed = !compileunit(*dirty[n], exports, optlevel);
+	});
+
+	if(!collecterrors(units, err))
+		return false;
+
+	std::vector<std::string> objects;
+	for(std::unique_ptr<Unit> & unit : units)
+		objects.push_back(unit->object);
+
+	if(dirty.empty() && linked(output, objects))
+		return true;
+
+	return linkexecutable(objects, output, err);
+}
+
+}
@@ -0,0 +1,33 @@
+/*
+    multi-file project builds
+    Copyright (C) 2012  microcai <microcai@fedoraproject.org>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace qbc{
+
+// 多文件工程: 每个源文件单独编译成目标文件 (和 -c 一样放在源文件旁边), 再一起链接成 output.
+// 文件之间可以互相调用 EXPORT 的 FUNCTION/SUB, 只要有一个文件里有 main.
+// 目标文件旁边的 .dep 记下源码的 hash 和用到的外部函数的签名,
+// 两者都没变的文件不重新编译. jobs 个线程并行解析和编译.
+bool buildproject(const std::vector<std::string> & sources, const std::string & output,
+				  unsigned optlevel, unsigned jobs, std::string & err);
+
+}
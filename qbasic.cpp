@@ -0,0 +1,92 @@
+/*
+    embedding API: compile QBASIC source and call it from C++
+    Copyright (C) 2012  microcai <microcai@fedoraproject.org>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include <mutex>
+
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/ExecutionEngine/ExecutionEngine.h>
+#include <llvm/Support/TargetSelect.h>
+
+#include "qbasic.hpp"
+#include "frontend.hpp"
+#include "emitter.hpp"
+#include "optimizer.hpp"
+#include "jit.hpp"
+
+namespace qbc{
+
+static std::once_flag targetinit;
+
+Script::Script()
+{
+}
+
+Script::~Script()
+{
+}
+
+Script * Script::compile(const std::string & source, std::string & err, unsigned optlevel, bool budgeted)
+{
+	std::call_once(targetinit, []{
+		llvm::InitializeNativeTarget();
+		llvm::InitializeNativeTargetAsmPrinter();
+		llvm::InitializeNativeTargetAsmParser();
+	});
+
+	std::unique_ptr<Script> script(new Script);
+	script->context.reset(new llvm::LLVMContext);
+
+	llvm::Module * module = compilesource(source, *script->context, "script", err);
+	if(!module)
+		return NULL;
+
+	wrapmain(module);
+
+	RuntimeMemoryManager * mm = new RuntimeMemoryManager;
+
+	if(budgeted){
+		addbudgetchecks(module);
+		addquotasymbols(mm);
+	}
+
+	script->engine.reset(createjit(module, optlevel, err, mm));
+	if(!script->engine)
+		return NULL;
+
+	optimize(module, optlevel, script->engine->getTargetMachine());
+	script->engine->finalizeObject();
+	return script.release();
+}
+
+void * Script::lookup(const std::string & name)
+{
+	return (void*) engine->getFunctionAddress(name);
+}
+
+int Script::run()
+{
+	return runmain(engine.get());
+}
+
+int Script::run(const Budget & budget, std::string & err)
+{
+	return runbudgeted(engine.get(), budget, err);
+}
+
+}
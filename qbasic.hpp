@@ -0,0 +1,74 @@
+/*
+    embedding API: compile QBASIC source and call it from C++
+    Copyright (C) 2012  microcai <microcai@fedoraproject.org>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "budget.hpp"
+
+namespace llvm{
+class LLVMContext;
+class ExecutionEngine;
+}
+
+namespace qbc{
+
+// 一段编译好的 BASIC 程序. 它拥有自己的 LLVMContext 和 JIT,
+// 拿到的函数指针在 Script 析构之前有效. 一个进程里可以同时有任意多个,
+// 不同的 Script 可以在不同的线程里编译.
+//
+//   std::unique_ptr<qbc::Script> script(qbc::Script::compile(source, err));
+//   auto add = script->function<long(long, long)>("add"); // EXPORT FUNCTION add(...)
+//
+// 类型对应: LONG 是 long, STRING 是 char*, SUB 返回 void.
+class Script
+{
+	std::unique_ptr<llvm::LLVMContext>		context;
+	std::unique_ptr<llvm::ExecutionEngine>	engine; // 必须先于 context 析构
+
+	Script();
+public:
+	~Script();
+
+	// 编译源码. 失败返回 NULL, 错误信息放在 err.
+	// 语法错误和代码生成时发现的错误 (未定义的变量, 不支持的运算, 数组下标个数不对...) 都从这里返回,
+	// 只有编译器自己的 bug (内部的断言) 还会结束进程.
+	// budgeted 的话插入预算检查, 内存分配也计入配额, 这样的 Script 要用 run(budget, err) 执行.
+	static Script * compile(const std::string & source, std::string & err, unsigned optlevel = 2,
+							bool budgeted = false);
+
+	// EXPORT 的 FUNCTION/SUB 的地址, 没有就返回 NULL. 没有 EXPORT 的函数可能已经被内联或者删掉了.
+	void * lookup(const std::string & name);
+
+	template<typename Signature>
+	Signature * function(const std::string & name)
+	{
+		return reinterpret_cast<Signature*>(lookup(name));
+	}
+
+	// 执行顶层语句 (没有定义 FUNCTION/SUB 的程序就是 main), 返回退出码.
+	int run();
+
+	// 在预算内执行顶层语句. 超出预算返回 -1, 原因放在 err; 程序没释放的内存都会被释放.
+	// 同一时间一个进程里只能有一个在跑.
+	int run(const Budget & budget, std::string & err);
+};
+
+}
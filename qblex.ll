@@ -25,6 +25,7 @@
 %option noyywrap
 %option nounistd
 %option bison-bridge
+%option reentrant
 %x block_comment
 %x remark
 %x documentation
@@ -48,8 +49,6 @@ typedef parser::semantic_type YYSTYPE;
 typedef parser::token token;
 
 #define error printf
-/* Local variables. */
-int count = 0;                  /* for strings */
 
 %}
 
@@ -68,6 +67,9 @@ rem {
 	BEGIN(remark);
 }
 
+^"#!".* /* shebang line of a script */ {
+}
+
 "/*" {
    BEGIN (block_comment);
 }
@@ -79,7 +81,10 @@ rem {
 "'".* /* eat comment */ {
 }
 
-\;\n*				return token::tNEWLINE;
+\;\n* {
+	yylineno += strlen(yytext) - 1;
+	return token::tNEWLINE;
+}
 
 \n* {
 	yylineno += strlen(yytext);
@@ -99,6 +104,7 @@ end{whitespace}*struct							return token::tENDSTRUCDIM;
 
 function			return token::tFUNCTION;
 sub|subroutine		return token::tSUB;
+export				return token::tEXPORT;
 then				return token::tTHEN;
 else				return token::tELSE;
 if					{/*printf("if begin ! ======\n"); */return token::tIF;}
@@ -212,6 +218,8 @@ false {
 
 
 \"[^"\n]*(\"|\n) {
+   int count;                  /* for strings */
+
    if (yytext[yyleng - 1] == '\n') {
       printf ("string not terminated");
    }
@@ -252,7 +260,9 @@ false {
 %%
 
 /* Report an error. */
-void yyerror (char *msg) {
+void yyerror (yyscan_t yyscanner, char *msg) {
+   struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
    /* Report the error. */
    if (*yytext == '\n' || *yytext == '\0') {
       printf ("%s at end of line", msg);
@@ -0,0 +1,232 @@
+/*
+    interactive QBASIC on top of an incremental JIT
+    Copyright (C) 2012  microcai <microcai@fedoraproject.org>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include <cctype>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Verifier.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include "repl.hpp"
+#include "frontend.hpp"
+#include "optimizer.hpp"
+#include "jit.hpp"
+
+//#define debug	std::printf
+#define debug(...)
+
+namespace qbc{
+
+// 粗略地数一下这一行打开或者关闭了几层块, 块没有结束就继续读下一行.
+static int blockdepth(const std::string & line)
+{
+	std::vector<std::string> words;
+	std::string word;
+	bool quoted = false;
+
+	for(char c : line)
+	{
+		if(c == '"')
+			quoted = !quoted;
+		if(quoted)
+			continue;
+		if(c == '\'')
+			break; // 注释
+
+		if(std::isalnum((unsigned char) c) || c == '_' || c == '$'){
+			word += std::tolower((unsigned char) c);
+		}else if(!word.empty()){
+			words.push_back(word);
+			word.clear();
+		}
+	}
+	if(!word.empty())
+		words.push_back(word);
+
+	if(words.empty())
+		return 0;
+
+	const std::string & first = words.front();
+
+	if(first == "end")
+		return words.size() > 1 ? -1 : 0;
+	if(first == "endif" || first == "fi" || first == "wend")
+		return -1;
+	if(first == "function" || first == "sub" || first == "while" || first == "for"
+		|| first == "struct" || first == "structdim")
+		return 1;
+	if(first == "if" && words.back() == "then")
+		return 1;
+	return 0;
+}
+
+Repl::Repl(unsigned _optlevel)
+	: optlevel(_optlevel)
+	, counter(0)
+{
+	globals.globalscope = true;
+}
+
+bool Repl::eval(const std::string & chunk, std::string & err)
+{
+	if(!engine){
+		engine.reset(createjit(new llvm::Module("qbc.repl", context), optlevel, err));
+		if(!engine)
+			return false;
+	}
+
+	FILE * file = fmemopen((void*) chunk.data(), chunk.size(), "r");
+	if(!file){
+		err = "fmemopen failed";
+		return false;
+	}
+
+	ParseState state;
+	bool parsed = parse(file, state);
+	std::fclose(file);
+
+	if(!parsed){
+		err = state.error;
+		return false;
+	}
+
+	// 定义的函数要给后面输入的代码调用, 每次都在新的 module 里, 所以都导出.
+	for(FunctionDimAST * func : state.functions)
+		func->linkage = EXTERN;
+
+	// 没有 FUNCTION/SUB 的时候, 语句被包在 DefaultMainFunctionAST 里.
+	CodeBlockAST * block = state.useDefautSubMain
+		? static_cast<FunctionDimAST*>(state.program)->body.get()
+		: static_cast<CodeBlockAST*>(state.program);
+
+	if(!block)
+		return true;
+
+	std::string name = "qbc.repl." + std::to_string(++counter);
+	llvm::Module * module = new llvm::Module(name, context);
+
+	std::string errors;
+
+	ASTContext ctx;
+	ctx.module = module;
+	ctx.codeblock = &globals;
+	ctx.errors = &errors;
+
+	llvm::IRBuilder<> builder(context);
+	llvm::Function * func = NULL;
+
+	if(state.useDefautSubMain){
+		func = llvm::Function::Create(llvm::FunctionType::get(builder.getVoidTy(), false),
+									  llvm::Function::ExternalLinkage, name, module);
+		ctx.llvmfunc = func;
+		ctx.block = llvm::BasicBlock::Create(context, "entrypoint", func);
+	}
+
+	// 出错的时候把这次登记的符号撤掉.
+	std::map<std::string, DimAST*> saved = globals.symbols;
+
+	// 直接在 globals 里生成, 这样 DIM 的变量就是全局变量, 定义的函数也登记在 globals 里.
+	globals.statements = block->statements;
+	ctx.block = globals.Codegen(ctx);
+	globals.statements.clear();
+
+	// 源码有错, 下面和重复定义一样撤掉这次的符号, 丢掉 module.
+	if(!errors.empty())
+		err = errors;
+
+	if(func){
+		builder.SetInsertPoint(ctx.block);
+		builder.CreateRetVoid();
+	}
+
+	// 重复定义的函数和变量在 JIT 里会变成重复的符号.
+	for(llvm::Function & f : *module)
+	{
+		if(!f.isDeclaration() && saved.count(f.getName().str()))
+			err = f.getName().str() + " is already defined";
+	}
+	for(llvm::GlobalVariable & g : module->globals())
+	{
+		std::string gname = g.getName().str();
+		if(!g.isDeclaration() && gname.compare(0, 11, "qbc.global.") == 0 && saved.count(gname.substr(11)))
+			err = gname.substr(11) + " is already defined";
+	}
+
+	llvm::raw_string_ostream os(err);
+	if(!err.empty() || llvm::verifyModule(*module, &os)){
+		os.flush();
+		globals.symbols = saved;
+		delete module;
+		return false;
+	}
+
+	module->setDataLayout(engine->getDataLayout());
+	optimize(module, optlevel, engine->getTargetMachine());
+
+	engine->addModule(std::unique_ptr<llvm::Module>(module));
+
+	if(func){
+		void (*entry)() = (void (*)()) engine->getFunctionAddress(name);
+
+		if(!entry){
+			err = "failed to compile " + name;
+			return false;
+		}
+
+		debug("running %s\n", name.c_str());
+		entry();
+		std::fflush(stdout);
+	}
+	return true;
+}
+
+int Repl::loop()
+{
+	std::string chunk, line, err;
+	int depth = 0;
+
+	for(;;)
+	{
+		std::cout << (depth > 0 ? "... " : "> ") << std::flush;
+
+		if(!std::getline(std::cin, line))
+			break;
+
+		chunk += line + "\n";
+		depth += blockdepth(line);
+
+		if(depth > 0)
+			continue;
+
+		if(!eval(chunk, err))
+			std::cerr << err << std::endl;
+
+		chunk.clear();
+		err.clear();
+		depth = 0;
+	}
+
+	std::cout << std::endl;
+	return 0;
+}
+
+}
@@ -0,0 +1,51 @@
+/*
+    interactive QBASIC on top of an incremental JIT
+    Copyright (C) 2012  microcai <microcai@fedoraproject.org>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/ExecutionEngine/ExecutionEngine.h>
+
+#include "ast.hpp"
+
+namespace qbc{
+
+// 每段输入 (一行语句, 或者一整个 FUNCTION/SUB) 生成一个新的 module, 加到同一个 MCJIT 里.
+// 语句包进 qbc.repl.N 函数里立即执行; 顶层 DIM 的变量是全局变量,
+// FUNCTION/SUB 和变量都登记在 globals 里, 之后的输入可以继续使用.
+class Repl
+{
+	llvm::LLVMContext						context;
+	std::unique_ptr<llvm::ExecutionEngine>	engine; // 必须先于 context 析构
+	CodeBlockAST							globals;
+	unsigned								optlevel;
+	unsigned								counter;
+public:
+	Repl(unsigned optlevel);
+
+	// 编译并执行一段输入. 失败返回 false, 之前的定义不受影响.
+	bool eval(const std::string & chunk, std::string & err);
+
+	// 从 stdin 读输入, 直到 EOF.
+	int loop();
+};
+
+}
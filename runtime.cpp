@@ -0,0 +1,179 @@
+/*
+    link the BASIC runtime bitcode into generated modules
+    Copyright (C) 2012  microcai <microcai@fedoraproject.org>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#include <mutex>
+#include <set>
+#include <vector>
+
+#include <llvm/Bitcode/ReaderWriter.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/Linker/Linker.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+#include "runtime.hpp"
+
+#ifndef BRT_LIBRARY_DIR
+#define BRT_LIBRARY_DIR "."
+#endif
+
+//#define debug	std::printf
+#define debug(...)
+
+namespace qbc{
+
+static std::once_flag bitcodeonce;
+static std::unique_ptr<llvm::MemoryBuffer> bitcode;
+
+static void loadbitcode()
+{
+	llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer =
+		llvm::MemoryBuffer::getFile(BRT_LIBRARY_DIR "/brt.bc");
+
+	if(buffer)
+		bitcode = std::move(*buffer);
+	else
+		debug("no runtime bitcode: %s\n", buffer.getError().message().c_str());
+}
+
+// v 引用的全局符号, 常量表达式要递归进去.
+static void collectglobals(llvm::Value * v, std::set<llvm::GlobalValue*> & globals)
+{
+	if(llvm::GlobalValue * gv = llvm::dyn_cast<llvm::GlobalValue>(v)){
+		globals.insert(gv);
+		return;
+	}
+	if(llvm::Constant * c = llvm::dyn_cast<llvm::Constant>(v)){
+		for(llvm::Value * op : c->operands())
+			collectglobals(op, globals);
+	}
+}
+
+// func 或者它调用的 static 函数读写了可变的全局变量.
+static bool hasstate(llvm::Function * func, std::set<llvm::Function*> & visited)
+{
+	if(!visited.insert(func).second)
+		return false;
+
+	std::set<llvm::GlobalValue*> globals;
+	for(llvm::BasicBlock & bb : *func)
+		for(llvm::Instruction & inst : bb)
+			for(llvm::Value * op : inst.operands())
+				collectglobals(op, globals);
+
+	for(llvm::GlobalValue * gv : globals)
+	{
+		if(llvm::GlobalVariable * var = llvm::dyn_cast<llvm::GlobalVariable>(gv)){
+			if(!var->isConstant())
+				return true;
+		}else if(llvm::Function * callee = llvm::dyn_cast<llvm::Function>(gv)){
+			if(callee->hasLocalLinkage() && !callee->isDeclaration() && hasstate(callee, visited))
+				return true;
+		}
+	}
+	return false;
+}
+
+bool hasruntimebitcode()
+{
+	std::call_once(bitcodeonce, loadbitcode);
+	return bitcode != NULL;
+}
+
+bool linkruntime(llvm::Module * module)
+{
+	std::call_once(bitcodeonce, loadbitcode);
+
+	if(!bitcode)
+		return false;
+
+	std::set<llvm::GlobalValue*> existing;
+	for(llvm::GlobalValue & gv : module->global_values())
+	{
+		if(!gv.isDeclaration())
+			existing.insert(&gv);
+	}
+
+	llvm::ErrorOr<std::unique_ptr<llvm::Module>> runtime = llvm::getLazyBitcodeModule(
+		llvm::MemoryBuffer::getMemBuffer(bitcode->getMemBufferRef(), false), module->getContext());
+
+	if(!runtime){
+		debug("bad runtime bitcode: %s\n", runtime.getError().message().c_str());
+		return false;
+	}
+
+	if(module->getTargetTriple().empty())
+		module->setTargetTriple((*runtime)->getTargetTriple());
+
+	// 只拿 module 里声明了的.
+	if(llvm::Linker::linkModules(*module, std::move(*runtime), llvm::Linker::Flags::LinkOnlyNeeded))
+		return false;
+
+	std::vector<llvm::GlobalValue*> linked;
+	for(llvm::GlobalValue & gv : module->global_values())
+	{
+		if(!gv.isDeclaration() && !existing.count(&gv))
+			linked.push_back(&gv);
+	}
+
+	for(llvm::GlobalValue * gv : linked)
+	{
+		if(gv->hasLocalLinkage())
+			continue;
+
+		// 运行时的全局变量只在 libbrt 里有一份.
+		if(llvm::GlobalVariable * var = llvm::dyn_cast<llvm::GlobalVariable>(gv)){
+			var->setInitializer(NULL);
+			var->setLinkage(llvm::GlobalValue::ExternalLinkage);
+			continue;
+		}
+
+		llvm::Function * func = llvm::cast<llvm::Function>(gv);
+		std::set<llvm::Function*> visited;
+
+		if(hasstate(func, visited)){
+			func->deleteBody();
+		}else{
+			debug("runtime function %s can be inlined\n", func->getName().str().c_str());
+			func->setLinkage(llvm::GlobalValue::AvailableExternallyLinkage);
+		}
+	}
+
+	// 上面去掉函数体以后没人用的 static 函数和变量.
+	for(bool erased = true; erased; )
+	{
+		erased = false;
+		for(llvm::GlobalValue * & gv : linked)
+		{
+			if(!gv || !gv->hasLocalLinkage() || !gv->use_empty())
+				continue;
+
+			if(llvm::Function * func = llvm::dyn_cast<llvm::Function>(gv))
+				func->eraseFromParent();
+			else
+				llvm::cast<llvm::GlobalVariable>(gv)->eraseFromParent();
+
+			gv = NULL;
+			erased = true;
+		}
+	}
+	return true;
+}
+
+}
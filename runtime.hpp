@@ -0,0 +1,36 @@
+/*
+    link the BASIC runtime bitcode into generated modules
+    Copyright (C) 2012  microcai <microcai@fedoraproject.org>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+#pragma once
+
+#include <llvm/IR/Module.h>
+
+namespace qbc{
+
+// 把 BASIC 运行时的 bitcode (构建时生成的 brt.bc) 里 module 用到的函数链接进来,
+// 标成 available_externally: 优化的时候可以内联, 但不生成代码, 没内联的调用照旧
+// 由 libbrt / 进程里的运行时解析, 所以不会有两份运行时.
+// 读写全局变量的函数 (输出缓冲, 内存配额...) 保持外部调用, 状态只有一份.
+// 所以运行时把分配内存这些慢的部分拆成单独的函数, 见 brt.h.
+// 找不到 brt.bc 就什么也不做. 返回是否链接了什么.
+bool linkruntime(llvm::Module * module);
+
+// 构建时有没有生成 brt.bc. 没有的话 linkruntime 不做事, 运行时函数都不会内联.
+bool hasruntimebitcode();
+
+}
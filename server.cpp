@@ -0,0 +1,355 @@
+/*
+    compile server: keep the initialized LLVM targets resident
+    Copyright (C) 2012  microcai <microcai@fedoraproject.org>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include <cerrno>
+#include <climits>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+
+#include <llvm/Support/raw_ostream.h>
+
+#include "emitter.hpp"
+#include "server.hpp"
+
+//#define debug	std::printf
+#define debug(...)
+
+namespace qbc{
+
+// 请求最大 1M, 防止乱七八糟的客户端.
+static const uint32_t maxrequest = 1 << 20;
+
+static bool writeall(int fd, const void * buf, size_t len)
+{
+	const char * p = (const char *) buf;
+	while(len){
+		ssize_t n = ::write(fd, p, len);
+		if(n < 0 && errno == EINTR)
+			continue;
+		if(n <= 0)
+			return false;
+		p += n;
+		len -= n;
+	}
+	return true;
+}
+
+static bool readall(int fd, void * buf, size_t len)
+{
+	char * p = (char *) buf;
+	while(len){
+		ssize_t n = ::read(fd, p, len);
+		if(n < 0 && errno == EINTR)
+			continue;
+		if(n <= 0)
+			return false;
+		p += n;
+		len -= n;
+	}
+	return true;
+}
+
+static bool unixaddress(const std::string & path, sockaddr_un & addr)
+{
+	std::memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+
+	if(path.size() >= sizeof(addr.sun_path)){
+		llvm::errs() << path << ": socket path too long\n";
+		return false;
+	}
+	std::strcpy(addr.sun_path, path.c_str());
+	return true;
+}
+
+static bool sendrequest(int sock, const std::string & payload)
+{
+	uint32_t len = payload.size();
+	int fds[3] = { STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO };
+	char control[CMSG_SPACE(sizeof(fds))];
+
+	iovec iov = { &len, sizeof(len) };
+	msghdr msg;
+
+	std::memset(control, 0, sizeof(control));
+	std::memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = control;
+	msg.msg_controllen = sizeof(control);
+
+	cmsghdr * cmsg = CMSG_FIRSTHDR(&msg);
+	cmsg->cmsg_level = SOL_SOCKET;
+	cmsg->cmsg_type = SCM_RIGHTS;
+	cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+	std::memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+	if(::sendmsg(sock, &msg, 0) != sizeof(len))
+		return false;
+	return writeall(sock, payload.data(), payload.size());
+}
+
+// args[0] 是客户端的工作目录, 后面是命令行.
+static bool recvrequest(int sock, std::vector<std::string> & args, int fds[3])
+{
+	uint32_t len;
+	char control[CMSG_SPACE(sizeof(int) * 3)];
+
+	iovec iov = { &len, sizeof(len) };
+	msghdr msg;
+
+	std::memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = control;
+	msg.msg_controllen = sizeof(control);
+
+	if(::recvmsg(sock, &msg, 0) != sizeof(len))
+		return false;
+
+	cmsghdr * cmsg = CMSG_FIRSTHDR(&msg);
+	if(!cmsg || cmsg->cmsg_type != SCM_RIGHTS || cmsg->cmsg_len != CMSG_LEN(sizeof(int) * 3))
+		return false;
+	std::memcpy(fds, CMSG_DATA(cmsg), sizeof(int) * 3);
+
+	if(len > maxrequest)
+		return false;
+
+	std::string payload(len, '\0');
+	if(!readall(sock, &payload[0], len))
+		return false;
+
+	size_t start = 0, end;
+	while((end = payload.find('\0', start)) != std::string::npos){
+		args.push_back(payload.substr(start, end - start));
+		start = end + 1;
+	}
+	return !args.empty();
+}
+
+// 在 fork 出来的进程里处理一个连接. 再 fork 一次去跑 driver,
+// 这样 driver 里的 exit() 或者崩溃也能把退出码报告给客户端.
+// 请求能用 server 的身份跑任意命令, 只接受同一个用户的连接.
+static bool peerisowner(int conn)
+{
+#ifdef SO_PEERCRED
+	struct ucred cred;
+	socklen_t len = sizeof(cred);
+
+	if(::getsockopt(conn, SOL_SOCKET, SO_PEERCRED, &cred, &len) < 0)
+		return false;
+	return cred.uid == ::geteuid();
+#else
+	uid_t uid;
+	gid_t gid;
+
+	if(::getpeereid(conn, &uid, &gid) < 0)
+		return false;
+	return uid == ::geteuid();
+#endif
+}
+
+static void handle(int conn, drivermain driver)
+{
+	std::signal(SIGCHLD, SIG_DFL);
+
+	std::vector<std::string> args;
+	int fds[3];
+
+	if(!recvrequest(conn, args, fds))
+		_exit(1);
+
+	debug("request in %s\n", args[0].c_str());
+
+	pid_t pid = ::fork();
+
+	if(pid == 0){
+		::close(conn);
+
+		for(int i = 0; i < 3; i++){
+			::dup2(fds[i], i);
+			::close(fds[i]);
+		}
+
+		if(::chdir(args[0].c_str()) < 0){
+			std::perror(args[0].c_str());
+			_exit(1);
+		}
+
+		std::vector<char*> argv;
+		argv.push_back((char*) "qbc");
+		for(size_t i = 1; i < args.size(); i++)
+			argv.push_back(&args[i][0]);
+		argv.push_back(NULL);
+
+		int ret = driver(argv.size() - 1, argv.data());
+
+		// 不走 exit(), 析构 server 继承下来的全局对象没有意义.
+		std::fflush(NULL);
+		_exit(ret);
+	}
+
+	for(int i = 0; i < 3; i++)
+		::close(fds[i]);
+
+	int32_t ret = 1;
+	int status;
+
+	if(pid > 0 && ::waitpid(pid, &status, 0) == pid){
+		if(WIFEXITED(status))
+			ret = WEXITSTATUS(status);
+		else if(WIFSIGNALED(status))
+			ret = 128 + WTERMSIG(status);
+	}
+
+	writeall(conn, &ret, sizeof(ret));
+	_exit(0);
+}
+
+int runserver(const std::string & path, drivermain driver)
+{
+	std::string err;
+
+	// 预先建好所有优化级别的 TargetMachine, 子进程直接继承.
+	for(unsigned level = 0; level <= 3; level++)
+	{
+		if(!cachedtargetmachine(level, err)){
+			llvm::errs() << "failed to create target machine: " << err << "\n";
+			return 1;
+		}
+	}
+
+	sockaddr_un addr;
+	if(!unixaddress(path, addr))
+		return 1;
+
+	int sock = ::socket(AF_UNIX, SOCK_STREAM, 0);
+	if(sock < 0){
+		std::perror("socket");
+		return 1;
+	}
+
+	// 上次没有清理掉的 socket 文件. 别的文件不能删.
+	struct stat st;
+	if(::lstat(path.c_str(), &st) == 0){
+		if(!S_ISSOCK(st.st_mode)){
+			llvm::errs() << path << " exists and is not a socket\n";
+			::close(sock);
+			return 1;
+		}
+		::unlink(path.c_str());
+	}
+
+	// 只有自己能连上来, bind 之前就把权限收紧, 不留空隙.
+	mode_t mask = ::umask(0077);
+	int bound = ::bind(sock, (sockaddr*) &addr, sizeof(addr));
+	::umask(mask);
+
+	if(bound < 0 || ::chmod(path.c_str(), 0600) < 0 || ::listen(sock, SOMAXCONN) < 0){
+		std::perror(path.c_str());
+		::close(sock);
+		return 1;
+	}
+
+	// 处理连接的子进程由内核回收.
+	std::signal(SIGCHLD, SIG_IGN);
+
+	llvm::errs() << "listening on " << path << "\n";
+
+	for(;;)
+	{
+		int conn = ::accept(sock, NULL, NULL);
+
+		if(conn < 0){
+			if(errno == EINTR || errno == ECONNABORTED)
+				continue;
+			std::perror("accept");
+			break;
+		}
+
+		if(!peerisowner(conn)){
+			llvm::errs() << "rejected a connection from another user\n";
+			::close(conn);
+			continue;
+		}
+
+		pid_t pid = ::fork();
+
+		if(pid == 0){
+			::close(sock);
+			handle(conn, driver);
+		}
+		if(pid < 0)
+			std::perror("fork");
+
+		::close(conn);
+	}
+
+	::close(sock);
+	::unlink(path.c_str());
+	return 1;
+}
+
+int connectserver(const std::string & path, int argc, char ** argv)
+{
+	sockaddr_un addr;
+	if(!unixaddress(path, addr))
+		return 1;
+
+	int sock = ::socket(AF_UNIX, SOCK_STREAM, 0);
+	if(sock < 0 || ::connect(sock, (sockaddr*) &addr, sizeof(addr)) < 0){
+		std::perror(path.c_str());
+		return 1;
+	}
+
+	char cwd[PATH_MAX];
+	if(!::getcwd(cwd, sizeof(cwd))){
+		std::perror("getcwd");
+		return 1;
+	}
+
+	std::string payload(cwd);
+	payload.push_back('\0');
+
+	for(int i = 0; i < argc; i++){
+		payload += argv[i];
+		payload.push_back('\0');
+	}
+
+	int32_t ret;
+
+	if(!sendrequest(sock, payload) || !readall(sock, &ret, sizeof(ret))){
+		llvm::errs() << path << ": server closed the connection\n";
+		::close(sock);
+		return 1;
+	}
+
+	::close(sock);
+	return ret;
+}
+
+}
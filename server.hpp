@@ -0,0 +1,40 @@
+/*
+    compile server: keep the initialized LLVM targets resident
+    Copyright (C) 2012  microcai <microcai@fedoraproject.org>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+#pragma once
+
+#include <string>
+
+namespace qbc{
+
+typedef int (*drivermain)(int argc, char ** argv);
+
+// 常驻在 unix socket 上. 每个请求 fork 一个子进程跑 driver, 子进程继承已经
+// 初始化好的 target 和各优化级别的 TargetMachine, 省掉每次启动的开销.
+// 请求可以是 driver 支持的任何命令行: --run, -c, -o ...
+//
+// 协议: 客户端先发一个 uint32 的长度, 同时用 SCM_RIGHTS 带上自己的
+// stdin/stdout/stderr, 然后是 "工作目录\0参数1\0参数2\0..." .
+// 编译器和程序的输出直接写到客户端的终端上, 最后 server 回一个 int32 的退出码.
+// socket 文件的权限是 0600, 别的用户的连接直接断开.
+int runserver(const std::string & path, drivermain driver);
+
+// 把 argv 交给 server 执行, 返回远端的退出码.
+int connectserver(const std::string & path, int argc, char ** argv);
+
+}
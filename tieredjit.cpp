@@ -0,0 +1,210 @@
+/*
+    tiered JIT: cheap code first, hot functions recompiled at -O3
+    Copyright (C) 2012  microcai <microcai@fedoraproject.org>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include <atomic>
+#include <cstdio>
+#include <vector>
+
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Transforms/Utils/Cloning.h>
+
+#include "jit.hpp"
+#include "tieredjit.hpp"
+#include "optimizer.hpp"
+
+//#define debug	std::printf
+#define debug(...)
+
+namespace qbc{
+
+// 计数器到达阈值时, 生成的代码调用它.
+static void tierupcallback(void * jit, const char * name)
+{
+	static_cast<TieredJIT*>(jit)->tierup(name);
+}
+
+// 第二层的 engine 先到第一层的 engine 里找桩和全局变量, 找不到再按运行时的规则找.
+class Tier2MemoryManager : public RuntimeMemoryManager
+{
+	llvm::ExecutionEngine * tier1;
+public:
+	Tier2MemoryManager(llvm::ExecutionEngine * _tier1) : tier1(_tier1) {}
+
+	virtual uint64_t getSymbolAddress(const std::string & name)
+	{
+		if(uint64_t addr = tier1->getGlobalValueAddress(name))
+			return addr;
+		return RuntimeMemoryManager::getSymbolAddress(name);
+	}
+};
+
+TieredJIT::TieredJIT(uint64_t _threshold)
+	: LazyJIT(0)
+	, stopping(false)
+	, threshold(_threshold)
+	, worker(&TieredJIT::workerloop, this)
+{
+	directrecursion = false;
+}
+
+TieredJIT::~TieredJIT()
+{
+	{
+		std::lock_guard<std::mutex> guard(queuelock);
+		stopping = true;
+	}
+	queuecond.notify_all();
+	worker.join();
+
+	for(auto & item : pristine)
+		delete item.second;
+}
+
+TieredJIT * TieredJIT::create(llvm::Module * module, uint64_t threshold, std::string & err)
+{
+	std::unique_ptr<TieredJIT> jit(new TieredJIT(threshold));
+
+	if(!jit->split(module, err))
+		return NULL;
+	return jit.release();
+}
+
+void TieredJIT::addsymbols(RuntimeMemoryManager * mm)
+{
+	LazyJIT::addsymbols(mm);
+	mm->addsymbol("__qbc_tier_up", (void*) &tierupcallback);
+}
+
+// 在函数入口和每条循环回边的起点插入:
+//   hotness += 1; if(hotness == threshold) __qbc_tier_up(jit, "name");
+void TieredJIT::instrument(const std::string & name, llvm::Module * module)
+{
+	llvm::LLVMContext & context = module->getContext();
+	llvm::IRBuilder<> builder(context);
+
+	llvm::Function * func = module->getFunction(name + bodysuffix);
+
+	llvm::GlobalVariable * counter = new llvm::GlobalVariable(*module, builder.getInt64Ty(), false,
+		llvm::GlobalValue::InternalLinkage, builder.getInt64(0), name + ".hotness");
+
+	llvm::Constant * tierupfunc = module->getOrInsertFunction("__qbc_tier_up",
+		llvm::FunctionType::get(builder.getVoidTy(), {builder.getInt8PtrTy(), builder.getInt8PtrTy()}, false));
+
+	llvm::Constant * self = llvm::ConstantExpr::getIntToPtr(
+		builder.getInt64((uint64_t)(uintptr_t) this), builder.getInt8PtrTy());
+
+	llvm::Constant * funcname = llvm::ConstantDataArray::getString(context, name);
+	llvm::GlobalVariable * namevar = new llvm::GlobalVariable(*module, funcname->getType(), true,
+		llvm::GlobalValue::PrivateLinkage, funcname, name + ".name");
+
+	addcounterchecks(func, counter, 1, llvm::CmpInst::ICMP_EQ, threshold, tierupfunc,
+		{self, llvm::ConstantExpr::getPointerCast(namevar, builder.getInt8PtrTy())}, "tier");
+}
+
+void * TieredJIT::compilemodule(const std::string & name, llvm::Module * module)
+{
+	module->setDataLayout(engine->getDataLayout());
+
+	pristine[name] = llvm::CloneModule(module).release();
+
+	// 第一层不跑 IR 优化.
+	instrument(name, module);
+
+	engine->addModule(std::unique_ptr<llvm::Module>(module));
+	return (void*) engine->getFunctionAddress(name + bodysuffix);
+}
+
+void TieredJIT::tierup(const std::string & name)
+{
+	debug("%s is hot, queued for -O3\n", name.c_str());
+	{
+		std::lock_guard<std::mutex> guard(queuelock);
+		hotqueue.push_back(name);
+	}
+	queuecond.notify_one();
+}
+
+void TieredJIT::recompile(const std::string & name)
+{
+	// LLVMContext 不是线程安全的, 和第一次调用时的编译互斥.
+	std::lock_guard<std::recursive_mutex> guard(lock);
+
+	std::map<std::string, llvm::Module*>::iterator it = pristine.find(name);
+	if(it == pristine.end())
+		return;
+
+	llvm::Module * module = it->second;
+	pristine.erase(it);
+
+	// 第一层的 engine 是 CodeGenOpt::None (FastISel, 快速寄存器分配), 第二层用自己的 -O3 engine.
+	if(!tier2)
+	{
+		std::string err;
+		RuntimeMemoryManager * mm = new Tier2MemoryManager(engine.get());
+		addsymbols(mm);
+
+		tier2.reset(createjit(new llvm::Module("qbc.tier2", module->getContext()), 3, err, mm));
+		if(!tier2){
+			llvm::errs() << "failed to create the -O3 JIT: " << err << "\n";
+			delete module;
+			return;
+		}
+	}
+
+	// 和第一层的 foo.body 区分开.
+	module->getFunction(name + bodysuffix)->setName(name + ".tier2");
+
+	module->setDataLayout(tier2->getDataLayout());
+	optimize(module, 3, tier2->getTargetMachine());
+	tier2->addModule(std::unique_ptr<llvm::Module>(module));
+
+	uint64_t addr = tier2->getFunctionAddress(name + ".tier2");
+	uint64_t slot = engine->getGlobalValueAddress(name + ".lazyptr");
+
+	if(!addr || !slot)
+		return;
+
+	// 桩每次调用都重新读 lazyptr, 正在执行的第一层代码跑完当前调用后就切换过去.
+	reinterpret_cast<std::atomic<uint64_t>*>(slot)->store(addr, std::memory_order_release);
+
+	debug("%s switched to -O3 code\n", name.c_str());
+}
+
+void TieredJIT::workerloop()
+{
+	for(;;)
+	{
+		std::string name;
+		{
+			std::unique_lock<std::mutex> guard(queuelock);
+			queuecond.wait(guard, [this]{ return stopping || !hotqueue.empty(); });
+
+			if(stopping)
+				return;
+
+			name = hotqueue.front();
+			hotqueue.pop_front();
+		}
+		recompile(name);
+	}
+}
+
+}
@@ -0,0 +1,63 @@
+/*
+    tiered JIT: cheap code first, hot functions recompiled at -O3
+    Copyright (C) 2012  microcai <microcai@fedoraproject.org>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
+#include "lazyjit.hpp"
+
+namespace qbc{
+
+// 在 LazyJIT 的基础上分两层编译:
+//   第一层: 第一次调用时不做 IR 优化直接编译, 函数入口和循环回边上插计数器.
+//   第二层: 计数达到阈值, 后台线程把未插桩的副本按 -O3 重新编译成 foo.tier2,
+//           放进单独的 -O3 engine (后端也是 -O3), 对其他函数和全局变量的引用解析到第一层,
+//           然后原子地改写 foo.lazyptr, 之后的调用都进入优化过的版本.
+// 递归调用也走桩, 这样深递归的函数也能切换过去.
+class TieredJIT : public LazyJIT
+{
+	std::map<std::string, llvm::Module*>	pristine; // 未插桩的副本, 留给第二层用
+	std::deque<std::string>					hotqueue;
+	std::mutex								queuelock;
+	std::condition_variable					queuecond;
+	bool									stopping;
+	uint64_t								threshold;
+	std::unique_ptr<llvm::ExecutionEngine>	tier2; // 第二层的代码, CodeGenOpt::Aggressive
+	std::thread								worker;
+
+	TieredJIT(uint64_t threshold);
+
+	void instrument(const std::string & name, llvm::Module * module);
+	void recompile(const std::string & name);
+	void workerloop();
+protected:
+	virtual void * compilemodule(const std::string & name, llvm::Module * module);
+	virtual void addsymbols(RuntimeMemoryManager * mm);
+public:
+	virtual ~TieredJIT();
+
+	static TieredJIT * create(llvm::Module * module, uint64_t threshold, std::string & err);
+
+	// 计数器到达阈值时由生成的代码调用, 只是排队.
+	void tierup(const std::string & name);
+};
+
+}
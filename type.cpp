@@ -62,9 +62,9 @@ ExprTypeASTPtr StringExprTypeAST::GetStringExprTypeAST()
 	return stringtype;
 }
 
-ExprTypeASTPtr ArrayExprTypeAST::create(ExprTypeASTPtr elementtype)
+ExprTypeASTPtr ArrayExprTypeAST::create(ExprTypeASTPtr elementtype, ExprListASTPtr dims)
 {
-	return std::make_shared<ArrayExprTypeAST>(elementtype);
+	return std::make_shared<ArrayExprTypeAST>(elementtype, dims);
 }
 
 ExprTypeASTPtr StructExprTypeAST::create(const std::string __typename)
@@ -106,6 +106,13 @@ ExprTypeASTPtr CalcExprAST::type(ASTContext ctx)
 	return lval->type(ctx);
 }
 
+ExprASTPtr CalcExprAST::appendto(ASTContext ctx, DimAST * var)
+{
+	if(op == OPERATOR_ADD && var && lval->variable(ctx) == var)
+		return rval;
+	return ExprASTPtr();
+}
+
 ExprTypeASTPtr CallExprAST::type(ASTContext ctx)
 {
 	ExprTypeASTPtr typeast = calltarget->nameresolve(ctx)->type;
@@ -141,30 +148,31 @@ llvm::Type* NumberExprTypeAST::llvm_type(ASTContext ctx)
 		case 8:
 			return llvm::Type::getInt64Ty(ctx.module->getContext());
 		case 4:
-			return llvm::Type::getInt32Ty(llvm::getGlobalContext());
+			return llvm::Type::getInt32Ty(ctx.module->getContext());
 	}
-	return llvm::Type::getInt32Ty(llvm::getGlobalContext());
+	return llvm::Type::getInt32Ty(ctx.module->getContext());
 }
 
 llvm::Type* StringExprTypeAST::llvm_type(ASTContext ctx)
 {
-	return llvm::Type::getInt8PtrTy(llvm::getGlobalContext());
+	return llvm::Type::getInt8PtrTy(ctx.module->getContext());
 }
 
 // the llvm_type of array is in fact QBArray
+// 每个 LLVMContext 有自己的 QBArray, 所以按名字在 module 里找, 不能缓存在 static 里.
 llvm::Type* ArrayExprTypeAST::llvm_type(ASTContext ctx)
 {
-	static llvm::Type * arraytype =NULL;
+	llvm::StructType * arraytype = ctx.module->getTypeByName("QBArray");
 	if(!arraytype){
 		std::vector<llvm::Type*>	members;
 
 		members.push_back(llvm::Type::getInt8PtrTy(ctx.module->getContext()));
 
- 		members.push_back(qbc::getplatformlongtype());
-		members.push_back(qbc::getplatformlongtype());
-		members.push_back(qbc::getplatformlongtype());
+ 		members.push_back(qbc::getplatformlongtype(ctx));
+		members.push_back(qbc::getplatformlongtype(ctx));
+		members.push_back(qbc::getplatformlongtype(ctx));
 
-		arraytype = llvm::StructType::create(members,"QBArray");
+		arraytype = llvm::StructType::create(ctx.module->getContext(), members, "QBArray");
 	}
 	return arraytype;
 }
@@ -210,12 +218,29 @@ llvm::Value* StringExprTypeAST::Alloca(ASTContext ctx, const std::string _name)
 
 	builder.SetInsertPoint(ctx.block);
 
-	llvm::Value * newval = builder.CreateAlloca(this->llvm_type(ctx),0,_name);
+	llvm::Value * slot = builder.CreateAlloca(qbc::getstrvartype(ctx),0,_name);
 
-	builder.CreateStore( qbc::getnull(), newval);
+	// 变量的指针就是 brt_strvar.ptr 的指针, 读写和以前的 char* 一样.
+	llvm::Value * newval = builder.CreateBitCast(slot, this->llvm_type(ctx)->getPointerTo());
+
+	builder.CreateStore( qbc::getnull(ctx), newval);
 	return newval;
 }
 
+llvm::Value* StringExprTypeAST::GlobalAlloca(ASTContext ctx, const std::string _name)
+{
+	llvm::Type * type = qbc::getstrvartype(ctx);
+
+	llvm::GlobalVariable * newval = new llvm::GlobalVariable(*ctx.module, type, false,
+		llvm::GlobalValue::ExternalLinkage, llvm::Constant::getNullValue(type), _name);
+
+	// 和数组一样执行到 DIM 的时候清空. 预算内再跑一次的时候, 上次的字符串已经被 brt_budget_stop 释放了.
+	llvm::IRBuilder<> builder(ctx.block);
+	builder.CreateStore(llvm::Constant::getNullValue(type), newval);
+
+	return llvm::ConstantExpr::getBitCast(newval, this->llvm_type(ctx)->getPointerTo());
+}
+
 llvm::Value* ArrayExprTypeAST::Alloca(ASTContext ctx, const std::string _name)
 {
 	debug("allocation for array %s type %s\n",_name.c_str() , this->elementtype->name(ctx).c_str());
@@ -228,10 +253,73 @@ llvm::Value* ArrayExprTypeAST::Alloca(ASTContext ctx, const std::string _name)
 	//call btr_qbarray_new()
 	llvm::Constant * btr_qbarray_new = qbc::getbuiltinprotype(ctx,"btr_qbarray_new");
 
-	builder.CreateCall(btr_qbarray_new, {newval, qbc::getconstlong(elementtype->size())});
+	builder.CreateCall(btr_qbarray_new, {builder.CreateBitCast(newval, builder.getInt8PtrTy()),
+		qbc::getconstlong(ctx, elementtype->size())});
 	return newval;
 }
 
+// 全局变量的初值全是 0, 对字符串来说就是 NULL.
+llvm::Value* ExprTypeAST::GlobalAlloca(ASTContext ctx, const std::string _name)
+{
+	llvm::Type * type = this->llvm_type(ctx);
+
+	llvm::GlobalVariable * newval = new llvm::GlobalVariable(*ctx.module, type, false,
+		llvm::GlobalValue::ExternalLinkage, llvm::Constant::getNullValue(type), _name);
+
+	initalize(ctx, newval);
+	return newval;
+}
+
+void ArrayExprTypeAST::initalize(ASTContext ctx, llvm::Value* Ptr)
+{
+	llvm::IRBuilder<> builder(ctx.block);
+
+	llvm::Constant * btr_qbarray_new = qbc::getbuiltinprotype(ctx,"btr_qbarray_new");
+
+	builder.CreateCall(btr_qbarray_new, {builder.CreateBitCast(Ptr, builder.getInt8PtrTy()),
+		qbc::getconstlong(ctx, elementtype->size())});
+}
+
+void ArrayExprTypeAST::dimension(ASTContext ctx, llvm::Value* Ptr, bool global, std::vector<llvm::Value*> & extents)
+{
+	if(!dims)
+		return;
+
+	llvm::IRBuilder<> builder(ctx.block);
+	llvm::Type * longtype = qbc::getplatformlongtype(ctx);
+
+	std::vector<llvm::Value*> sizes;
+	for(ExprASTPtr & dim : dims->expression_list)
+		sizes.push_back(dim->getval(ctx));
+
+	// 一行的字节数, 就是 stride.
+	llvm::Value * rowsize = qbc::getconstlong(ctx, elementtype->size());
+	for(size_t i = 1; i < sizes.size(); i++)
+		rowsize = builder.CreateMul(rowsize, sizes[i]);
+
+	// 检查下标和换算列号要用第二维起的大小, 存一份, DIM 以后变量改了也不影响.
+	extents.clear();
+	for(size_t i = 1; i < sizes.size(); i++)
+	{
+		llvm::Value * extent;
+
+		if(global){
+			extent = new llvm::GlobalVariable(*ctx.module, longtype, false, llvm::GlobalValue::ExternalLinkage,
+				llvm::Constant::getNullValue(longtype), Ptr->getName() + ".extent" + std::to_string(i));
+		}else{
+			llvm::IRBuilder<> entry(&ctx.llvmfunc->getEntryBlock(), ctx.llvmfunc->getEntryBlock().begin());
+			extent = entry.CreateAlloca(longtype, 0, "extent");
+		}
+
+		builder.CreateStore(sizes[i], extent);
+		extents.push_back(extent);
+	}
+
+	llvm::Constant * btr_qbarray_dim = qbc::getbuiltinprotype(ctx,"btr_qbarray_dim");
+
+	builder.CreateCall(btr_qbarray_dim, {builder.CreateBitCast(Ptr, builder.getInt8PtrTy()), sizes[0], rowsize});
+}
+
 llvm::Value* CallableExprTypeAST::Alloca(ASTContext ctx, const std::string _name)
 {
     ::printf("alloca function?\n");
@@ -246,7 +334,7 @@ llvm::Value* NumberExprTypeAST::deref(ASTContext ctx, llvm::Value* v)
 
 	debug("de reference long type\n");
 
-	llvm::Value * ptr = builder.CreateBitCast(v,qbc::getplatformlongtype()->getPointerTo());
+	llvm::Value * ptr = builder.CreateBitCast(v,qbc::getplatformlongtype(ctx)->getPointerTo());
 
 	return builder.CreateLoad(ptr);
 }
@@ -257,9 +345,18 @@ void StringExprTypeAST::destory(ASTContext ctx, llvm::Value* Ptr)
 
 	llvm::IRBuilder<>	builder(ctx.block);
 
-	llvm::Constant * func_free = qbc::getbuiltinprotype(ctx,"free");
+	llvm::Constant * func_release = qbc::getbuiltinprotype(ctx,"brt_str_release");
 
-	builder.CreateCall(func_free,builder.CreateLoad(Ptr));
+	builder.CreateCall(func_release,builder.CreateLoad(Ptr));
+}
+
+llvm::Value* StringExprTypeAST::retain(ASTContext ctx, llvm::Value* v)
+{
+	llvm::IRBuilder<>	builder(ctx.block);
+
+	llvm::Constant * func_retain = qbc::getbuiltinprotype(ctx,"brt_str_retain");
+
+	return builder.CreateCall(func_retain,v);
 }
 
 void ArrayExprTypeAST::destory(ASTContext ctx, llvm::Value* Ptr)
@@ -270,7 +367,7 @@ void ArrayExprTypeAST::destory(ASTContext ctx, llvm::Value* Ptr)
 
 	llvm::Constant * func_btr_qbarray_free = qbc::getbuiltinprotype(ctx,"btr_qbarray_free");
 
-	builder.CreateCall(func_btr_qbarray_free,Ptr);
+	builder.CreateCall(func_btr_qbarray_free,builder.CreateBitCast(Ptr, builder.getInt8PtrTy()));
 }
 
 llvm::Value* CallableExprTypeAST::defaultprototype(ASTContext ctx, std::string functionname)
@@ -285,7 +382,7 @@ llvm::Value* CallableExprTypeAST::defaultprototype(ASTContext ctx, std::string f
 
 llvm::Value* ConstNumberExprAST::getval(ASTContext ctx)
 {
-	return qbc::getconstlong(	this->v);
+	return qbc::getconstlong(ctx, this->v);
 }
 
 llvm::Value* ConstStringExprAST::getval(ASTContext ctx)
@@ -295,7 +392,15 @@ llvm::Value* ConstStringExprAST::getval(ASTContext ctx)
 	llvm::IRBuilder<>	builder(ctx.block);
 
 	// cache the result
-	return val = builder.CreateGlobalStringPtr( this->str );
+	return val = qbc::getconststring(ctx, this->str);
+}
+
+// 报错以后代替找不到的变量, 在当前作用域里补一个 LONG 变量, 后面再用到就不用再报了.
+static DimAST* placeholdervar(ASTContext ctx, const std::string & name)
+{
+	VariableDimAST * var = new VariableDimAST(name, NumberExprTypeAST::GetNumberExprTypeAST());
+	var->Codegen(ctx);
+	return var;
 }
 
 DimAST* VariableExprAST::nameresolve(ASTContext ctx)
@@ -305,28 +410,28 @@ DimAST* VariableExprAST::nameresolve(ASTContext ctx)
 
 // 	debug("searching for var %s\n",varname.c_str());
 
-	if(! ctx.codeblock ){
-		debug("var %s not defined\n",varname.c_str());
-		exit(1);
-		return NULL;
-	}
-
-	std::map< std::string, DimAST* >::iterator dimast_iter = ctx.codeblock->symbols.find(varname);
+	for(CodeBlockAST * block = ctx.codeblock; block; block = block->parent)
+	{
+		std::map< std::string, DimAST* >::iterator dimast_iter = block->symbols.find(varname);
 
-	if(dimast_iter != ctx.codeblock->symbols.end()){
+		if(dimast_iter != block->symbols.end()){
 
-		debug("searching for var %s have result %p\n",varname.c_str(),dimast_iter->second);
+			debug("searching for var %s have result %p\n",varname.c_str(),dimast_iter->second);
 
-		return dimast_iter->second;
+			return dimast_iter->second;
+		}
 	}
-	ctx.codeblock = ctx.codeblock->parent;
-	return nameresolve(ctx);
+
+	debug("var %s not defined\n",varname.c_str());
+	ctx.error(varname + " is not defined");
+	return placeholdervar(ctx, varname);
 }
 
 DimAST* NamedExprAST::nameresolve(ASTContext ctx)
 {
 	debug("NamedExprAST::nameresolve\n");
-	exit(1);
+	ctx.error("not a variable");
+	return placeholdervar(ctx, "qbc.error");
 }
 
 llvm::Value* TempNumberExprAST::getval(ASTContext)
@@ -355,9 +460,10 @@ llvm::Value* VariableExprAST::getptr(ASTContext ctx)
 	return nameresolve(ctx)->getptr(ctx);
 }
 
+// 取地址是为了赋值.
 llvm::Value* CallExprAST::getptr(ASTContext ctx)
 {
-	ExprASTPtr tmp = calltarget->type(ctx)->getop()->operator_call(ctx,calltarget,callargs);
+	ExprASTPtr tmp = calltarget->type(ctx)->getop()->operator_call(ctx,calltarget,callargs,true);
 	return tmp->getptr(ctx);
 }
 
@@ -369,7 +475,7 @@ llvm::Value* AssignmentExprAST::getval(ASTContext ctx)
 
 llvm::Value* CallExprAST::getval(ASTContext ctx)
 {
-	ExprASTPtr tmp = calltarget->type(ctx)->getop()->operator_call(ctx,calltarget,callargs);
+	ExprASTPtr tmp = calltarget->type(ctx)->getop()->operator_call(ctx,calltarget,callargs,false);
 	return tmp->getval(ctx);
 }
 
@@ -403,7 +509,9 @@ llvm::Value* CalcExprAST::getval(ASTContext ctx)
 			return result->getval(ctx);
 		default:
 			debug("operator not supported yet\n");
-			exit(1);
+			ctx.error("operator not supported yet");
+			if(!result)
+				result = errorplaceholder(ctx);
 	}
 	return result->getval(ctx);
 }
@@ -431,8 +539,9 @@ ConstStringExprAST::ConstStringExprAST(const std::string _str)
 }
 
 
-ArrayExprTypeAST::ArrayExprTypeAST(ExprTypeASTPtr _elementtype)
+ArrayExprTypeAST::ArrayExprTypeAST(ExprTypeASTPtr _elementtype, ExprListASTPtr _dims)
 	:elementtype(_elementtype)
+	,dims(_dims)
 {
 }
 
@@ -488,15 +597,17 @@ TempNumberExprAST::TempNumberExprAST(ASTContext ctx,llvm::Value* numberresult, l
 
 }
 
-TempStringExprAST::TempStringExprAST(ASTContext ctx,llvm::Value* result , llvm::Value *ptr)
-	:TempExprAST(ctx,result,ptr,  stringtype)
+ExprASTPtr errorplaceholder(ASTContext ctx)
 {
+	llvm::IRBuilder<> entry(&ctx.llvmfunc->getEntryBlock(), ctx.llvmfunc->getEntryBlock().begin());
+	llvm::Value * ptr = entry.CreateAlloca(qbc::getplatformlongtype(ctx), 0, "error");
 
+	return std::make_shared<TempNumberExprAST>(ctx, (llvm::Value*) NULL, ptr);
 }
 
-TempStringExprAST::~TempStringExprAST()
+TempStringExprAST::TempStringExprAST(ASTContext ctx,llvm::Value* result , llvm::Value *ptr)
+	:TempExprAST(ctx,result,ptr,  stringtype)
 {
-	llvm::IRBuilder<>	builder(ctx.block);
-	llvm::Constant * func_free = qbc::getbuiltinprotype(ctx,"free");
-	builder.CreateCall(func_free,this->val);
+
 }
+
@@ -99,6 +99,7 @@ class MemberReferenceAST : public ReferenceAST
 
 class ExprOperation;
 class ExprAST;
+class DimAST;
 class PointerTypeAST;
 
 typedef std::shared_ptr<ExprAST>	ExprASTPtr;
@@ -118,15 +119,25 @@ public:
 	// allocate one on stack , if possible , name it
 	virtual llvm::Value * Alloca(ASTContext ctx, const std::string _name){return NULL;}
 
+	// allocate one as a global variable, zero filled then initalize()d
+	virtual llvm::Value * GlobalAlloca(ASTContext ctx, const std::string _name);
+
 	// dereference the pointer 
 	virtual llvm::Value * deref(ASTContext ctx, llvm::Value *v);
 
 	// initalize the default vaule
 	virtual void initalize(ASTContext, llvm::Value * Ptr) {};
 
+	// ARRAYDIM a(n, m) 按给定的大小分配, 换算下标要用的各维大小存到 extents.
+	// extents 是变量自己的 (VariableDimAST::extents), 同一个类型可能生成好几次代码.
+	virtual void dimension(ASTContext, llvm::Value * Ptr, bool global, std::vector<llvm::Value*> & extents) {};
+
 	// generate the call to deconstruction function here!
 	virtual void destory(ASTContext, llvm::Value * Ptr) {};
 
+	// take one more reference to the value v, for the caller of a function returning it
+	virtual llvm::Value * retain(ASTContext, llvm::Value * v) {return v;};
+
 	virtual	size_t size(){return _size;};
 
 	// get operation table
@@ -168,6 +179,12 @@ public:
 	virtual llvm::Value *getval(ASTContext) = 0;
 	virtual llvm::Value *getptr(ASTContext) = 0;
 
+	// 变量返回它的定义, 其他表达式返回 NULL.
+	virtual DimAST * variable(ASTContext){return NULL;}
+
+	// 是 var + tail 的话返回 tail, 用来把 s$ = s$ + x$ 生成成追加.
+	virtual ExprASTPtr appendto(ASTContext, DimAST * var){return ExprASTPtr();}
+
     virtual ~ExprAST(){}
 };
 
@@ -211,6 +228,9 @@ public:
     virtual llvm::Value* getval(ASTContext );
 };
 
+// 报错 (ASTContext::error) 以后代替结果的值: 一个 LONG 临时变量, 能读也能写.
+ExprASTPtr errorplaceholder(ASTContext ctx);
+
 class ConstNumberExprAST : public ExprAST
 {
 	int v;
@@ -239,7 +259,6 @@ class TempStringExprAST : public TempExprAST
 {
 public:
     TempStringExprAST(ASTContext ctx,llvm::Value * result , llvm::Value *ptr);
-    virtual ~TempStringExprAST();
 };
 
 #if 0
@@ -276,6 +295,7 @@ public:
     virtual llvm::Value* getptr(ASTContext );
 
     virtual DimAST* nameresolve(ASTContext ctx);
+    virtual DimAST* variable(ASTContext ctx){return nameresolve(ctx);}
 	
 	virtual ExprTypeASTPtr type(ASTContext ctx);
     virtual ~VariableExprAST(){}
@@ -290,6 +310,7 @@ public:
 	CalcExprAST(ExprAST * , MathOperator op , ExprAST * );
 	virtual ExprTypeASTPtr type(ASTContext);
     virtual llvm::Value* getval(ASTContext);
+    virtual ExprASTPtr appendto(ASTContext, DimAST * var);
 	virtual llvm::Value* getptr(ASTContext){exit(177);}
 };
 
@@ -387,13 +408,16 @@ public:
     StringExprTypeAST();
     virtual llvm::Type* llvm_type(ASTContext ctx);
 
+    // 数组元素只是一个指针. 变量是 struct brt_strvar, 短字符串就放在里面.
     virtual size_t size(){return sizeof(size_t);}
 
 	virtual llvm::Value* Alloca(ASTContext ctx, const std::string _name);
+	virtual llvm::Value* GlobalAlloca(ASTContext ctx, const std::string _name);
     virtual ExprOperation* getop();
     virtual PointerTypeASTPtr getpointetype();;
 	
     virtual void destory(ASTContext , llvm::Value* Ptr);
+    virtual llvm::Value* retain(ASTContext , llvm::Value* v);
 
     virtual ExprASTPtr createtemp(ASTContext , llvm::Value*  , llvm::Value *ptr);
 	
@@ -408,24 +432,30 @@ class ArrayExprTypeAST : public ExprTypeAST
 	 * NOTE:
 	 *
 	 * An Array is of the type  struct QBArray
+	 *
+	 * 多维数组按行存放, 同 C. QBArray.stride 是第一个下标加 1 移动的字节数,
+	 * 其余下标在一行里面换算成列号.
 	 **/
 	ExprTypeASTPtr	elementtype;
+	ExprListASTPtr	dims; // ARRAYDIM a(n, m) 的各维大小, 没有就是一维, 随用随长.
 	friend class ArrayExprOperation;
 	friend class CallExprAST;
 public:
-    ArrayExprTypeAST(ExprTypeASTPtr elementtype);
+    ArrayExprTypeAST(ExprTypeASTPtr elementtype, ExprListASTPtr dims = ExprListASTPtr());
     virtual llvm::Type* llvm_type(ASTContext ctx);
 
     virtual size_t size(){return sizeof(struct QBArray);}
 
 	virtual llvm::Value* Alloca(ASTContext ctx, const std::string _name);
+    virtual void initalize(ASTContext ctx, llvm::Value * Ptr);
+    virtual void dimension(ASTContext ctx, llvm::Value * Ptr, bool global, std::vector<llvm::Value*> & extents);
     virtual ExprOperation* getop();
     virtual PointerTypeASTPtr getpointetype(){ ::printf("get pointer to type\n");exit(1);};
     virtual void destory(ASTContext , llvm::Value* Ptr);
     virtual ExprASTPtr createtemp(ASTContext , llvm::Value*  , llvm::Value *ptr);
 
 public:
-	static ExprTypeASTPtr create(ExprTypeASTPtr);
+	static ExprTypeASTPtr create(ExprTypeASTPtr, ExprListASTPtr dims = ExprListASTPtr());
 };
 #if 0
 //  函数对象类型. 这是基类
@@ -509,7 +539,7 @@ public:
 	virtual	ExprASTPtr operator_assign(ASTContext , NamedExprASTPtr lval, ExprASTPtr rval);
 
 	// 加法运算, 对于字符串来说, 这运算过程会生成一个临时字符串,
-	// 临时字符串 AST 对象将会被 AST节点被析构的时候向当前llvm basicbody 位置插入临时字符串的释放指令.
+	// 临时字符串登记在 ctx.temps 里, 整条语句用完以后才插入释放指令.
 	virtual ExprASTPtr operator_add(ASTContext , ExprASTPtr lval, ExprASTPtr rval);
 
 	// 减法运算, 对于字符串来说无此类型的运算. 试图对字符串执行减法导致一个编译期错误.
@@ -525,7 +555,8 @@ public:
 	virtual	ExprASTPtr operator_comp(ASTContext, MathOperator op, ExprASTPtr lval,ExprASTPtr rval);
 
 	// 括号操作, 也就是函数调用, 或者是数组下标寻址.
-	virtual ExprASTPtr operator_call(ASTContext, NamedExprASTPtr target, ExprListASTPtr callargslist);
+	// store 是要往结果里写 (赋值), 数组只有写的时候才扩容.
+	virtual ExprASTPtr operator_call(ASTContext, NamedExprASTPtr target, ExprListASTPtr callargslist, bool store);
 };
 
 class NumberExprOperation : public ExprOperation {
@@ -545,11 +576,11 @@ class StringExprOperation : public ExprOperation {
 
 class ArrayExprOperation : public ExprOperation{
 	virtual ExprASTPtr operator_assign(ASTContext ctx,NamedExprASTPtr lval,ExprASTPtr rval);
-    virtual ExprASTPtr operator_call(ASTContext , NamedExprASTPtr target, ExprListASTPtr callargslist);	
+    virtual ExprASTPtr operator_call(ASTContext , NamedExprASTPtr target, ExprListASTPtr callargslist, bool store);
 };
 
 class FunctionExprOperation : public ExprOperation{
-    virtual ExprASTPtr operator_call(ASTContext , NamedExprASTPtr target, ExprListASTPtr callargslist);
+    virtual ExprASTPtr operator_call(ASTContext , NamedExprASTPtr target, ExprListASTPtr callargslist, bool store);
 };
 
 class PointerTypeOperation: public ExprOperation{